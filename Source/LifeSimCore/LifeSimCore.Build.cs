@@ -0,0 +1,13 @@
+using UnrealBuildTool;
+
+// Engine-independent simulation rules and state. Core only, so everything in
+// here can be stepped and benchmarked without a world or any UObjects.
+public class LifeSimCore : ModuleRules
+{
+	public LifeSimCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core" });
+	}
+}
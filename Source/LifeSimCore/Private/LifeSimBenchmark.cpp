@@ -0,0 +1,101 @@
+#include "LifeSimBenchmark.h"
+#include "LifeSimCoreState.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Same density as the default 20x20 map with 16 organisms and ~40 food items,
+	// so per-entity cost stays comparable across population sizes
+	constexpr float AreaPerOrganism = (20 * 200.0f) * (20 * 200.0f) / 16.0f;
+	constexpr float FoodPerOrganism = 2.5f;
+	constexpr float BenchmarkDeltaTime = 1.0f / 60.0f;
+
+	FLifeSimCoreState MakeBenchmarkState(int32 NumEntities)
+	{
+		FRandomStream Random(1234);
+
+		FLifeSimCoreState State;
+		const float HalfExtent = FMath::Sqrt(AreaPerOrganism * NumEntities) * 0.5f;
+		State.Bounds = FBox2D(FVector2D(-HalfExtent), FVector2D(HalfExtent));
+		State.Food.Grid.Initialize(FVector(-HalfExtent, -HalfExtent, 0.0f), 200.0f);
+
+		// Mixed population: some hungry, some ready to reproduce, some with memories
+		State.Organisms.Reserve(NumEntities);
+		for (int32 i = 0; i < NumEntities; i++)
+		{
+			const FVector Location(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f);
+			const int32 Index = State.Organisms.Add(Location, Random.FRandRange(1.0f, State.Tuning.MaxEnergy), Random.RandHelper(MAX_int32));
+			State.Organisms.TimeSinceLastReproduction[Index] = Random.FRandRange(0.0f, 2.0f * State.Tuning.ReproductionCooldown);
+
+			const int32 NumMemories = Random.RandRange(0, State.Tuning.MaxFoodMemories);
+			for (int32 m = 0; m < NumMemories; m++)
+			{
+				const FVector MemoryLocation = Location + FVector(Random.FRandRange(-300.0f, 300.0f), Random.FRandRange(-300.0f, 300.0f), 0.0f);
+				State.Organisms.Memories[Index].Remember(State.Food.Grid.GetCell(MemoryLocation), -Random.FRandRange(0.0f, State.Tuning.MemoryDecayTime),
+					State.Tuning.MemoryDecayTime, State.Tuning.MaxFoodMemories);
+			}
+		}
+
+		const int32 NumFood = FMath::RoundToInt(NumEntities * FoodPerOrganism);
+		for (int32 i = 0; i < NumFood; i++)
+		{
+			State.Food.Add(FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 0.0f));
+		}
+
+		return State;
+	}
+
+	template<typename StepType>
+	void TimeStep(const TCHAR* Name, const FLifeSimCoreState& Prototype, int32 Iterations, StepType&& Step, TArray<FLifeSimBenchmarkResult>& OutResults)
+	{
+		double BestSeconds = TNumericLimits<double>::Max();
+
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			// Fresh copy each run, eating and reproduction change the population
+			FLifeSimCoreState State = Prototype;
+
+			const double StartTime = FPlatformTime::Seconds();
+			Step(State);
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+		}
+
+		FLifeSimBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = Name;
+		Result.NumEntities = Prototype.Organisms.Num();
+		Result.NanosecondsPerEntity = Result.NumEntities > 0 ? BestSeconds * 1e9 / Result.NumEntities : 0.0;
+	}
+}
+
+void RunLifeSimCoreBenchmarks(int32 NumEntities, int32 Iterations, TArray<FLifeSimBenchmarkResult>& OutResults)
+{
+	const FLifeSimCoreState Prototype = MakeBenchmarkState(NumEntities);
+	Iterations = FMath::Max(Iterations, 1);
+
+	TimeStep(TEXT("Metabolism"), Prototype, Iterations, [](FLifeSimCoreState& State) { State.StepMetabolism(BenchmarkDeltaTime); }, OutResults);
+	TimeStep(TEXT("Seeking"), Prototype, Iterations, [](FLifeSimCoreState& State) { State.StepSeeking(BenchmarkDeltaTime); }, OutResults);
+	TimeStep(TEXT("Eating"), Prototype, Iterations, [](FLifeSimCoreState& State) { State.StepEating(); }, OutResults);
+	TimeStep(TEXT("Reproduction"), Prototype, Iterations, [](FLifeSimCoreState& State) { State.StepReproduction(); }, OutResults);
+}
+
+static FAutoConsoleCommand LifeSimBenchCoreCommand(
+	TEXT("lifesim.Bench.Core"),
+	TEXT("Times each core simulation rule at 1k/10k/100k organisms and logs ns per entity. Optional argument: iterations (default 5)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 5;
+		const int32 PopulationSizes[] = { 1000, 10000, 100000 };
+
+		for (const int32 NumEntities : PopulationSizes)
+		{
+			TArray<FLifeSimBenchmarkResult> Results;
+			RunLifeSimCoreBenchmarks(NumEntities, Iterations, Results);
+
+			for (const FLifeSimBenchmarkResult& Result : Results)
+			{
+				UE_LOG(LogTemp, Log, TEXT("lifesim.Bench.Core %-12s %7d entities %8.1f ns/entity"),
+					*Result.Name, Result.NumEntities, Result.NanosecondsPerEntity);
+			}
+		}
+	}));
@@ -0,0 +1,175 @@
+#include "LifeSimCoreState.h"
+#include "LifeSimRules.h"
+
+void FOrganismSoA::Reserve(int32 Count)
+{
+	Location.Reserve(Count);
+	Direction.Reserve(Count);
+	Energy.Reserve(Count);
+	Age.Reserve(Count);
+	TimeSinceDirectionChange.Reserve(Count);
+	DirectionChangeInterval.Reserve(Count);
+	TimeSinceLastReproduction.Reserve(Count);
+	Random.Reserve(Count);
+	Memories.Reserve(Count);
+}
+
+int32 FOrganismSoA::Add(const FVector& InLocation, float InEnergy, int32 Seed)
+{
+	Location.Add(InLocation);
+	Direction.Add(FVector::ZeroVector);
+	Energy.Add(InEnergy);
+	Age.Add(0.0f);
+	TimeSinceDirectionChange.Add(0.0f);
+	DirectionChangeInterval.Add(0.0f);
+	TimeSinceLastReproduction.Add(0.0f);
+	Random.Add(FRandomStream(Seed));
+	Memories.AddDefaulted();
+	return Energy.Num() - 1;
+}
+
+void FOrganismSoA::RemoveAtSwap(int32 Index)
+{
+	Location.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Direction.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Energy.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Age.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TimeSinceDirectionChange.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DirectionChangeInterval.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TimeSinceLastReproduction.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Random.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Memories.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+int32 FFoodSoA::Add(const FVector& InLocation)
+{
+	const int32 Index = Location.Add(InLocation);
+	bAlive.Add(true);
+	Grid.Add(Index, InLocation);
+	return Index;
+}
+
+void FFoodSoA::Remove(int32 Index)
+{
+	// Slots are not reused, indices stay stable for the grid
+	if (bAlive[Index])
+	{
+		bAlive[Index] = false;
+		Grid.Remove(Index, Location[Index]);
+	}
+}
+
+bool FLifeSimCoreState::FindNearestFood(const FVector& Location, float Radius, int32& OutFood, FVector& OutFoodLocation) const
+{
+	const TSpatialHashGrid<int32>::FEntry* Nearest = Food.Grid.FindNearest(Location, Radius);
+	if (!Nearest)
+		return false;
+
+	OutFood = Nearest->Element;
+	OutFoodLocation = Nearest->Location;
+	return true;
+}
+
+bool FLifeSimCoreState::FindFoodInCell(const FIntPoint& Cell, int32& OutFood, FVector& OutFoodLocation) const
+{
+	const TArray<TSpatialHashGrid<int32>::FEntry>* Entries = Food.Grid.GetCellEntries(Cell);
+	if (!Entries || Entries->Num() == 0)
+		return false;
+
+	OutFood = (*Entries)[0].Element;
+	OutFoodLocation = (*Entries)[0].Location;
+	return true;
+}
+
+void FLifeSimCoreState::StepMetabolism(float DeltaTime)
+{
+	Time += DeltaTime;
+
+	for (int32 i = Organisms.Num() - 1; i >= 0; i--)
+	{
+		Organisms.Energy[i] = LifeSimRules::Metabolize(Organisms.Energy[i], Tuning.MetabolismRate, DeltaTime);
+		Organisms.Age[i] += DeltaTime;
+		Organisms.TimeSinceLastReproduction[i] += DeltaTime;
+
+		if (LifeSimRules::IsStarved(Organisms.Energy[i]))
+		{
+			Organisms.RemoveAtSwap(i);
+		}
+	}
+}
+
+void FLifeSimCoreState::StepSeeking(float DeltaTime)
+{
+	const bool bHasBounds = Bounds.bIsValid;
+
+	for (int32 i = 0; i < Organisms.Num(); i++)
+	{
+		FVector& Location = Organisms.Location[i];
+
+		if (bHasBounds)
+		{
+			LifeSimRules::ReflectOffBounds(Bounds, Location, Organisms.Direction[i]);
+		}
+
+		if (LifeSimRules::IsHungry(Organisms.Energy[i], Tuning.HungerThreshold))
+		{
+			int32 FoodIndex;
+			FVector FoodLocation;
+			const bool bFoundFood = Organisms.Memories[i].FindFood(Time, Tuning.MemoryDecayTime,
+				[this, &FoodIndex, &FoodLocation](const FIntPoint& Cell)
+				{
+					return FindFoodInCell(Cell, FoodIndex, FoodLocation);
+				})
+				|| FindNearestFood(Location, Tuning.DetectionRadius, FoodIndex, FoodLocation);
+
+			if (bFoundFood)
+			{
+				LifeSimRules::MoveToward(Location, FoodLocation, Tuning.MovementSpeed, DeltaTime);
+				continue;
+			}
+		}
+
+		LifeSimRules::Wander(Organisms.Direction[i], Organisms.TimeSinceDirectionChange[i], Organisms.DirectionChangeInterval[i],
+			Tuning.DirectionChangeIntervalMin, Tuning.DirectionChangeIntervalMax, Organisms.Random[i],
+			Tuning.MovementSpeed, DeltaTime, Location);
+	}
+}
+
+void FLifeSimCoreState::StepEating()
+{
+	for (int32 i = 0; i < Organisms.Num(); i++)
+	{
+		int32 FoodIndex;
+		FVector FoodLocation;
+		if (!FindNearestFood(Organisms.Location[i], LifeSimRules::EatRadius, FoodIndex, FoodLocation))
+			continue;
+
+		Organisms.Memories[i].Remember(Food.Grid.GetCell(FoodLocation), Time, Tuning.MemoryDecayTime, Tuning.MaxFoodMemories);
+		Organisms.Energy[i] = LifeSimRules::Eat(Organisms.Energy[i], Tuning.FoodEnergyValue, Tuning.MaxEnergy);
+		Food.Remove(FoodIndex);
+	}
+}
+
+void FLifeSimCoreState::StepReproduction()
+{
+	// Offspring are appended and do not reproduce in the step they are born
+	const int32 NumParents = Organisms.Num();
+	for (int32 i = 0; i < NumParents; i++)
+	{
+		if (Organisms.Num() >= OrganismCap)
+			return;
+
+		if (!LifeSimRules::CanReproduce(Organisms.Energy[i], Tuning.ReproductionThreshold,
+			Organisms.TimeSinceLastReproduction[i], Tuning.ReproductionCooldown))
+		{
+			continue;
+		}
+
+		Organisms.Energy[i] -= Tuning.ReproductionCost;
+		Organisms.TimeSinceLastReproduction[i] = 0.0f;
+
+		const FVector OffspringDirection = LifeSimRules::RandomPlanarDirection(Organisms.Random[i]);
+		const int32 Seed = Organisms.Random[i].GetUnsignedInt();
+		Organisms.Add(Organisms.Location[i] + OffspringDirection * LifeSimRules::OffspringDistance, Tuning.MaxEnergy * 0.5f, Seed);
+	}
+}
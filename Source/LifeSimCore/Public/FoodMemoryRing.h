@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The places an organism last found food, at most Capacity of them, stored
+// inline. A place is a cell of the food spatial index, and each entry keeps
+// the simulation time it was last found at instead of a timer, so memories
+// cost nothing per step: expired entries are skipped when read and are the
+// first to be overwritten, then the one found longest ago. Finding food in a
+// known cell refreshes that entry.
+struct FFoodMemoryRing
+{
+	static constexpr int32 Capacity = 4;
+
+	struct FEntry
+	{
+		// Cells are clamped to int16, far beyond any environment grid
+		int16 CellX = 0;
+		int16 CellY = 0;
+		float FoundTime = 0.0f;
+
+		FIntPoint GetCell() const
+		{
+			return FIntPoint(CellX, CellY);
+		}
+	};
+
+	void Reset()
+	{
+		NumEntries = 0;
+	}
+
+	// MaxMemories is clamped to 1..Capacity, it should not change over the organism's life
+	void Remember(const FIntPoint& Cell, float Now, float DecayTime, int32 MaxMemories)
+	{
+		const int32 Size = FMath::Clamp(MaxMemories, 1, Capacity);
+		const int16 CellX = (int16)FMath::Clamp(Cell.X, (int32)MIN_int16, (int32)MAX_int16);
+		const int16 CellY = (int16)FMath::Clamp(Cell.Y, (int32)MIN_int16, (int32)MAX_int16);
+
+		// Refresh a memory of this cell if we already have one
+		int32 Slot = INDEX_NONE;
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			if (Entries[i].CellX == CellX && Entries[i].CellY == CellY)
+			{
+				Entries[i].FoundTime = Now;
+				return;
+			}
+
+			// Forgotten entries are reused before anything is evicted
+			if (Slot == INDEX_NONE && IsExpired(Entries[i], Now, DecayTime))
+			{
+				Slot = i;
+			}
+		}
+
+		if (Slot == INDEX_NONE)
+		{
+			if (NumEntries < Size)
+			{
+				Slot = NumEntries++;
+			}
+			else
+			{
+				// Forget the one found longest ago, refreshed entries stay
+				Slot = 0;
+				for (int32 i = 1; i < Size; i++)
+				{
+					if (Entries[i].FoundTime < Entries[Slot].FoundTime)
+					{
+						Slot = i;
+					}
+				}
+			}
+		}
+
+		Entries[Slot].CellX = CellX;
+		Entries[Slot].CellY = CellY;
+		Entries[Slot].FoundTime = Now;
+	}
+
+	// Calls FindFood(Cell) for each remembered cell until one still has food
+	template<typename FindFoodType>
+	bool FindFood(float Now, float DecayTime, FindFoodType&& FindFood) const
+	{
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			if (!IsExpired(Entries[i], Now, DecayTime) && FindFood(Entries[i].GetCell()))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	int32 NumRemembered(float Now, float DecayTime) const
+	{
+		int32 Count = 0;
+		for (int32 i = 0; i < NumEntries; i++)
+		{
+			Count += IsExpired(Entries[i], Now, DecayTime) ? 0 : 1;
+		}
+		return Count;
+	}
+
+private:
+	static bool IsExpired(const FEntry& Entry, float Now, float DecayTime)
+	{
+		return Now - Entry.FoundTime > DecayTime;
+	}
+
+	FEntry Entries[Capacity];
+	uint8 NumEntries = 0;
+};
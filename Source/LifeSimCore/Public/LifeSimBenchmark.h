@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FLifeSimBenchmarkResult
+{
+	FString Name;
+	int32 NumEntities = 0;
+	double NanosecondsPerEntity = 0.0;
+};
+
+// Times each FLifeSimCoreState update on a generated population of NumEntities
+// organisms, without a world. Results are the best of Iterations runs.
+// Also available as the console command lifesim.Bench.Core [Iterations].
+LIFESIMCORE_API void RunLifeSimCoreBenchmarks(int32 NumEntities, int32 Iterations, TArray<FLifeSimBenchmarkResult>& OutResults);
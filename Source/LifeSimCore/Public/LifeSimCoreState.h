@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpatialHashGrid.h"
+#include "FoodMemoryRing.h"
+
+// Organisms as structs-of-arrays: index i in every array is organism i
+struct LIFESIMCORE_API FOrganismSoA
+{
+	TArray<FVector> Location;
+	TArray<FVector> Direction;
+	TArray<float> Energy;
+	TArray<float> Age;
+	TArray<float> TimeSinceDirectionChange;
+	TArray<float> DirectionChangeInterval;
+	TArray<float> TimeSinceLastReproduction;
+	TArray<FRandomStream> Random;
+	TArray<FFoodMemoryRing> Memories;
+
+	int32 Num() const { return Energy.Num(); }
+	void Reserve(int32 Count);
+	int32 Add(const FVector& InLocation, float InEnergy, int32 Seed);
+	void RemoveAtSwap(int32 Index);
+};
+
+struct LIFESIMCORE_API FFoodSoA
+{
+	TArray<FVector> Location;
+	TArray<bool> bAlive;
+
+	// Indices of live food
+	TSpatialHashGrid<int32> Grid;
+
+	int32 Num() const { return Location.Num(); }
+	int32 Add(const FVector& InLocation);
+	void Remove(int32 Index);
+};
+
+// Tuning shared by every organism. Defaults match what the game runs: the
+// AOrganismActor defaults, UResourceComponent's organism metabolism rate and
+// AFoodActor's energy value.
+struct FOrganismTuning
+{
+	float MaxEnergy = 100.0f;
+	float MetabolismRate = 0.5f;
+	float MovementSpeed = 100.0f;
+	float DetectionRadius = 250.0f;
+	float HungerThreshold = 40.0f;
+	float ReproductionThreshold = 90.0f;
+	float ReproductionCost = 50.0f;
+	float ReproductionCooldown = 120.0f;
+	float DirectionChangeIntervalMin = 2.0f;
+	float DirectionChangeIntervalMax = 5.0f;
+	int32 MaxFoodMemories = 3;
+	float MemoryDecayTime = 300.0f;
+	float FoodEnergyValue = 40.0f;
+};
+
+// The whole simulation without a world: one update function per rule,
+// each running over every organism. Used by the microbenchmarks.
+struct LIFESIMCORE_API FLifeSimCoreState
+{
+	FOrganismSoA Organisms;
+	FFoodSoA Food;
+	FOrganismTuning Tuning;
+	FBox2D Bounds = FBox2D(ForceInit);
+	int32 OrganismCap = MAX_int32;
+
+	// Simulation time, food memories are stamped with it
+	float Time = 0.0f;
+
+	// Metabolism, aging and reproduction cooldown, and advances Time. Removes starved organisms.
+	void StepMetabolism(float DeltaTime);
+
+	// Hungry organisms head for remembered or visible food, the rest wander
+	void StepSeeking(float DeltaTime);
+
+	// Organisms in reach of food eat it, first come first served
+	void StepEating();
+
+	// Organisms that can reproduce spawn one offspring each, up to OrganismCap
+	void StepReproduction();
+
+private:
+	bool FindNearestFood(const FVector& Location, float Radius, int32& OutFood, FVector& OutFoodLocation) const;
+	bool FindFoodInCell(const FIntPoint& Cell, int32& OutFood, FVector& OutFoodLocation) const;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The organism rules as pure functions on plain values. AOrganismActor, the
+// Mass step processor and FLifeSimCoreState all call these, so there is a
+// single definition of each rule and it can be benchmarked without a world.
+namespace LifeSimRules
+{
+	// Distances the rules are tuned around
+	constexpr float EatRadius = 50.0f; // Food this close gets eaten
+	constexpr float OffspringDistance = 100.0f;
+
+	FORCEINLINE float Metabolize(float Energy, float MetabolismRate, float DeltaTime)
+	{
+		return Energy - MetabolismRate * DeltaTime;
+	}
+
+	FORCEINLINE bool IsStarved(float Energy)
+	{
+		return Energy <= 0.0f;
+	}
+
+	FORCEINLINE bool IsHungry(float Energy, float HungerThreshold)
+	{
+		return Energy < HungerThreshold;
+	}
+
+	FORCEINLINE float Eat(float Energy, float FoodEnergy, float MaxEnergy)
+	{
+		return FMath::Min(Energy + FoodEnergy, MaxEnergy);
+	}
+
+	FORCEINLINE bool CanReproduce(float Energy, float ReproductionThreshold, float TimeSinceLastReproduction, float ReproductionCooldown)
+	{
+		return Energy >= ReproductionThreshold && TimeSinceLastReproduction >= ReproductionCooldown;
+	}
+
+	// Random direction on the horizontal plane
+	FORCEINLINE FVector RandomPlanarDirection(FRandomStream& Random)
+	{
+		const float X = Random.FRandRange(-1.0f, 1.0f);
+		const float Y = Random.FRandRange(-1.0f, 1.0f);
+		return FVector(X, Y, 0.0f).GetSafeNormal();
+	}
+
+	FORCEINLINE void MoveToward(FVector& Location, const FVector& Target, float MovementSpeed, float DeltaTime)
+	{
+		Location += (Target - Location).GetSafeNormal() * MovementSpeed * DeltaTime;
+	}
+
+	// Keeps walking in Direction, picking a new one every IntervalMin..IntervalMax seconds
+	inline void Wander(FVector& Direction, float& TimeSinceDirectionChange, float& DirectionChangeInterval,
+		float IntervalMin, float IntervalMax, FRandomStream& Random, float MovementSpeed, float DeltaTime, FVector& Location)
+	{
+		TimeSinceDirectionChange += DeltaTime;
+
+		if (TimeSinceDirectionChange >= DirectionChangeInterval || Direction.IsZero())
+		{
+			Direction = RandomPlanarDirection(Random);
+			TimeSinceDirectionChange = 0.0f;
+			DirectionChangeInterval = Random.FRandRange(IntervalMin, IntervalMax);
+		}
+
+		Location += Direction * MovementSpeed * DeltaTime;
+	}
+
+	// Clamps Location into Bounds and turns Direction back inside. Returns true if it hit an edge.
+	inline bool ReflectOffBounds(const FBox2D& Bounds, FVector& Location, FVector& Direction)
+	{
+		bool bHitBoundary = false;
+
+		if (Location.X < Bounds.Min.X)
+		{
+			Location.X = Bounds.Min.X;
+			Direction.X = FMath::Abs(Direction.X); // Bounce right
+			bHitBoundary = true;
+		}
+		else if (Location.X > Bounds.Max.X)
+		{
+			Location.X = Bounds.Max.X;
+			Direction.X = -FMath::Abs(Direction.X); // Bounce left
+			bHitBoundary = true;
+		}
+
+		if (Location.Y < Bounds.Min.Y)
+		{
+			Location.Y = Bounds.Min.Y;
+			Direction.Y = FMath::Abs(Direction.Y); // Bounce up
+			bHitBoundary = true;
+		}
+		else if (Location.Y > Bounds.Max.Y)
+		{
+			Location.Y = Bounds.Max.Y;
+			Direction.Y = -FMath::Abs(Direction.Y); // Bounce down
+			bHitBoundary = true;
+		}
+
+		if (bHitBoundary)
+		{
+			Direction.Normalize();
+		}
+
+		return bHitBoundary;
+	}
+}
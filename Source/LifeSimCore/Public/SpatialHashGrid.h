@@ -0,0 +1,162 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Uniform spatial hash on the environment's XY cell grid.
+// Elements are stored by value together with the location they were added at,
+// so queries never have to touch the element itself to measure distances.
+template<typename ElementType>
+class TSpatialHashGrid
+{
+public:
+	struct FEntry
+	{
+		ElementType Element;
+		FVector Location;
+	};
+
+	TSpatialHashGrid()
+		: Origin(FVector::ZeroVector)
+		, CellSize(100.0f)
+		, NumElements(0)
+	{
+	}
+
+	// Origin is the world position of cell (0, 0)'s corner
+	void Initialize(const FVector& InOrigin, float InCellSize)
+	{
+		Origin = InOrigin;
+		CellSize = FMath::Max(InCellSize, 1.0f);
+		Reset();
+	}
+
+	void Reset()
+	{
+		Cells.Reset();
+		NumElements = 0;
+	}
+
+	int32 Num() const
+	{
+		return NumElements;
+	}
+
+	float GetCellSize() const
+	{
+		return CellSize;
+	}
+
+	FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(
+			FMath::FloorToInt((Location.X - Origin.X) / CellSize),
+			FMath::FloorToInt((Location.Y - Origin.Y) / CellSize));
+	}
+
+	void Add(const ElementType& Element, const FVector& Location)
+	{
+		Cells.FindOrAdd(GetCell(Location)).Add(FEntry{ Element, Location });
+		NumElements++;
+	}
+
+	// Location must be the one the element was added with
+	bool Remove(const ElementType& Element, const FVector& Location)
+	{
+		const FIntPoint Cell = GetCell(Location);
+		TArray<FEntry>* Entries = Cells.Find(Cell);
+		if (!Entries)
+			return false;
+
+		for (int32 i = 0; i < Entries->Num(); i++)
+		{
+			if ((*Entries)[i].Element == Element)
+			{
+				Entries->RemoveAtSwap(i, 1, EAllowShrinking::No);
+				NumElements--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Entries stored in a single cell, or nullptr if the cell is empty
+	const TArray<FEntry>* GetCellEntries(const FIntPoint& Cell) const
+	{
+		return Cells.Find(Cell);
+	}
+
+	// Calls Visitor(const FEntry&) for every entry within Radius of Center
+	template<typename VisitorType>
+	void ForEachInRadius(const FVector& Center, float Radius, VisitorType&& Visitor) const
+	{
+		if (NumElements == 0)
+			return;
+
+		const float RadiusSquared = Radius * Radius;
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius, Radius, 0.0f));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius, Radius, 0.0f));
+
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+			{
+				const TArray<FEntry>* Entries = Cells.Find(FIntPoint(X, Y));
+				if (!Entries)
+					continue;
+
+				for (const FEntry& Entry : *Entries)
+				{
+					if (FVector::DistSquared(Center, Entry.Location) < RadiusSquared)
+					{
+						Visitor(Entry);
+					}
+				}
+			}
+		}
+	}
+
+	// Any allocator, e.g. a scratch array for results that only live for one query
+	template<typename AllocatorType>
+	void QueryRadius(const FVector& Center, float Radius, TArray<ElementType, AllocatorType>& OutElements) const
+	{
+		ForEachInRadius(Center, Radius, [&OutElements](const FEntry& Entry)
+		{
+			OutElements.Add(Entry.Element);
+		});
+	}
+
+	int32 CountInRadius(const FVector& Center, float Radius) const
+	{
+		int32 Count = 0;
+		ForEachInRadius(Center, Radius, [&Count](const FEntry&)
+		{
+			Count++;
+		});
+		return Count;
+	}
+
+	// Closest entry strictly within Radius of Center, or nullptr if there is none
+	const FEntry* FindNearest(const FVector& Center, float Radius) const
+	{
+		const FEntry* Nearest = nullptr;
+		float NearestDistanceSquared = Radius * Radius;
+
+		ForEachInRadius(Center, Radius, [&Nearest, &NearestDistanceSquared, &Center](const FEntry& Entry)
+		{
+			const float DistanceSquared = FVector::DistSquared(Center, Entry.Location);
+			if (DistanceSquared < NearestDistanceSquared)
+			{
+				NearestDistanceSquared = DistanceSquared;
+				Nearest = &Entry;
+			}
+		});
+
+		return Nearest;
+	}
+
+private:
+	FVector Origin;
+	float CellSize;
+	int32 NumElements;
+	TMap<FIntPoint, TArray<FEntry>> Cells;
+};
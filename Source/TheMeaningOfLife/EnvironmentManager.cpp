@@ -2,13 +2,43 @@
 #include "FoodActor.h"
 #include "OrganismActor.h"
 #include "PlantActor.h"
-#include "DrawDebugHelpers.h"
+#include "Components/LineBatchComponent.h"
+#include "LifeSimSubsystem.h"
+#include "OrganismMassSubsystem.h"
+#include "ResourceComponent.h"
+#include "LifeSimStats.h"
+#include "LifeSimAllocTracker.h"
+#include "LifeSimMemory.h"
+
+// Counts and times one food index query, only while someone is looking at the numbers
+struct FFoodQueryScope
+{
+	FFoodQueryScope(bool bInEnabled, std::atomic<int32>& InCount, std::atomic<uint64>& InCycles)
+		: bEnabled(bInEnabled), Count(InCount), Cycles(InCycles), StartCycles(bInEnabled ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FFoodQueryScope()
+	{
+		if (!bEnabled)
+			return;
+
+		Count.fetch_add(1, std::memory_order_relaxed);
+		Cycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+	}
+
+	bool bEnabled;
+	std::atomic<int32>& Count;
+	std::atomic<uint64>& Cycles;
+	uint64 StartCycles;
+};
 
 // Sets default values
 AEnvironmentManager::AEnvironmentManager()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+ 	// Ticks only to notice grid changes, the lines themselves persist
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickInterval = 0.5f;
 
 	// Default grid settings
 	GridWidth = 20;
@@ -25,6 +55,27 @@ AEnvironmentManager::AEnvironmentManager()
 
 	// Visualization
 	bShowGridLines = true;
+	GridLines = nullptr;
+	GridLinesHash = 0;
+
+	bSpatialGridsInitialized = false;
+	FoodIndexReaders = 0;
+	bTrackFoodQueries = false;
+	FoodQueryCount = 0;
+	FoodQueryCycles = 0;
+	LifeSim = nullptr;
+}
+
+void AEnvironmentManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Register before anything begins play so every actor finds us in the context
+	LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+	if (LifeSim)
+	{
+		LifeSim->RegisterEnvironment(this);
+	}
 }
 
 // Called when the game starts or when spawned
@@ -35,20 +86,70 @@ void AEnvironmentManager::BeginPlay()
 	UE_LOG(LogTemp, Warning, TEXT("Environment Manager initialized: %dx%d grid, cell size %f"),
 		GridWidth, GridHeight, CellSize);
 
+	if (!bSpatialGridsInitialized)
+	{
+		InitializeSpatialGrids();
+	}
+
+	// Ticking only keeps the grid lines up to date
+#if ENABLE_DRAW_DEBUG
+	const bool bDrawGrid = !ULifeSimSubsystem::IsHeadless();
+#else
+	const bool bDrawGrid = false;
+#endif
+	SetActorTickEnabled(bDrawGrid);
+	if (bDrawGrid)
+	{
+		UpdateGridLines();
+	}
+
+	PrewarmPools();
+
 	SpawnInitialPlants();
 	SpawnInitialOrganism();
 }
 
+void AEnvironmentManager::PrewarmPools()
+{
+	if (!LifeSim)
+		return;
+
+	// Size the pools for a full population so booms reuse actors instead of spawning them
+	UResourceComponent* Resources = LifeSim->GetContext().Resources;
+
+	if (OrganismActorClass && !UOrganismMassSubsystem::IsEnabled())
+	{
+		LIFESIM_LLM_SCOPE(Organisms);
+		const int32 OrganismCap = Resources ? Resources->GetOrganismCap() : 0;
+		LifeSim->PrewarmPool(OrganismActorClass, FMath::Max(InitialOrganismCount, OrganismCap));
+	}
+
+	if (FoodActorClass && PlantActorClass)
+	{
+		// Every plant keeps up to MaxFoodNearby food around it
+		LIFESIM_LLM_SCOPE(Food);
+		const int32 PlantCap = Resources ? Resources->GetPlantCap() : 0;
+		const int32 FoodPerPlant = PlantActorClass->GetDefaultObject<APlantActor>()->MaxFoodNearby;
+		LifeSim->PrewarmPool(FoodActorClass, FMath::Max(InitialPlantCount, PlantCap) * FoodPerPlant);
+	}
+}
+
+void AEnvironmentManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (LifeSim)
+	{
+		LifeSim->UnregisterEnvironment(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AEnvironmentManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Draw grid for visualization
-	if (bShowGridLines)
-	{
-		DrawGrid();
-	}
+	UpdateGridLines();
 }
 
 void AEnvironmentManager::SpawnInitialPlants()
@@ -59,7 +160,12 @@ void AEnvironmentManager::SpawnInitialPlants()
 		return;
 	}
 
-	for (int32 i = 0; i < InitialPlantCount; i++)
+	SpawnPlants(InitialPlantCount);
+}
+
+void AEnvironmentManager::SpawnPlants(int32 Count)
+{
+	for (int32 i = 0; i < Count; i++)
 	{
 		SpawnPlantAtRandomCell();
 	}
@@ -76,6 +182,7 @@ void AEnvironmentManager::SpawnPlantAtRandomCell()
 	FVector SpawnLocation = GetWorldPositionFromGridCell(RandomX, RandomY);
 	SpawnLocation.Z = PlantSpawnOffset;
 
+	LIFESIM_LLM_SCOPE(Plants);
 	FActorSpawnParameters SpawnParams;
 	AActor* NewPlant = GetWorld()->SpawnActor<APlantActor>(PlantActorClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
 
@@ -88,7 +195,6 @@ void AEnvironmentManager::SpawnPlantAtRandomCell()
 			Plant->FoodActorClass = FoodActorClass;
 		}
 
-		SpawnedPlants.Add(NewPlant);
 		// UE_LOG(LogTemp, Log, TEXT("Spawned plant at grid cell (%d, %d)"), RandomX, RandomY);
 	}
 }
@@ -101,7 +207,12 @@ void AEnvironmentManager::SpawnInitialOrganism()
 		return;
 	}
 
-	for (int32 i = 0; i < InitialOrganismCount; i++)
+	SpawnOrganisms(InitialOrganismCount);
+}
+
+void AEnvironmentManager::SpawnOrganisms(int32 Count)
+{
+	for (int32 i = 0; i < Count; i++)
 	{
 		SpawnOrganismAtRandomCell();
 	}
@@ -119,14 +230,21 @@ void AEnvironmentManager::SpawnOrganismAtRandomCell()
 	FVector SpawnLocation = GetWorldPositionFromGridCell(RandomX, RandomY);
 	SpawnLocation.Z = OrganismSpawnOffset; // Spawn slightly above ground
 
-	FActorSpawnParameters SpawnParams;
-	AActor* NewOrganism = GetWorld()->SpawnActor<AOrganismActor>(OrganismActorClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
+	LIFESIM_LLM_SCOPE(Organisms);
+
+	// Mass backend: an entity instead of an actor
+	UOrganismMassSubsystem* MassOrganisms = GetWorld()->GetSubsystem<UOrganismMassSubsystem>();
+	if (MassOrganisms && UOrganismMassSubsystem::IsEnabled())
+	{
+		MassOrganisms->SpawnOrganism(SpawnLocation, OrganismActorClass);
+		return;
+	}
 
-	if (NewOrganism)
+	if (LifeSim)
 	{
-		SpawnedOrganisms.Add(NewOrganism);
-		// UE_LOG(LogTemp, Log, TEXT("Spawned organism at grid cell (%d, %d)"), RandomX, RandomY);
+		LifeSim->AcquireActor<AOrganismActor>(OrganismActorClass, SpawnLocation);
 	}
+	// UE_LOG(LogTemp, Log, TEXT("Spawned organism at grid cell (%d, %d)"), RandomX, RandomY);
 }
 
 FVector AEnvironmentManager::GetWorldPositionFromGridCell(int32 X, int32 Y)
@@ -140,6 +258,16 @@ FVector AEnvironmentManager::GetWorldPositionFromGridCell(int32 X, int32 Y)
 	return FVector(WorldX, WorldY, ManagerLocation.Z);
 }
 
+FIntPoint AEnvironmentManager::GetGridCellFromWorldPosition(const FVector& Location) const
+{
+	FVector ManagerLocation = GetActorLocation();
+
+	int32 X = FMath::FloorToInt((Location.X - ManagerLocation.X) / CellSize + GridWidth / 2.0f);
+	int32 Y = FMath::FloorToInt((Location.Y - ManagerLocation.Y) / CellSize + GridHeight / 2.0f);
+
+	return FIntPoint(X, Y);
+}
+
 bool AEnvironmentManager::IsWithinBounds(FVector Location)
 {
 	FVector ManagerLocation = GetActorLocation();
@@ -153,17 +281,36 @@ bool AEnvironmentManager::IsWithinBounds(FVector Location)
 		Location.Y <= ManagerLocation.Y + HalfGridWorldHeight);
 }
 
-void AEnvironmentManager::DrawGrid()
+void AEnvironmentManager::UpdateGridLines()
 {
-	FVector ManagerLocation = GetActorLocation();
+	uint32 Hash = GetTypeHash(bShowGridLines);
+	Hash = HashCombine(Hash, GetTypeHash(GridWidth));
+	Hash = HashCombine(Hash, GetTypeHash(GridHeight));
+	Hash = HashCombine(Hash, GetTypeHash(CellSize));
+	Hash = HashCombine(Hash, GetTypeHash(GetActorLocation()));
+	if (GridLines && Hash == GridLinesHash)
+		return;
+
+	GridLinesHash = Hash;
 
+	if (!GridLines)
+	{
+		GridLines = NewObject<ULineBatchComponent>(this, TEXT("GridLines"));
+		GridLines->RegisterComponent();
+	}
+	GridLines->Flush();
+
+	if (!bShowGridLines)
+		return;
+
+	// Zero lifetime, the lines stay until the next Flush
 	// Draw vertical lines
 	for (int32 X = 0; X <= GridWidth; X++)
 	{
 		FVector Start = GetWorldPositionFromGridCell(X, 0);
 		FVector End = GetWorldPositionFromGridCell(X, GridHeight);
 
-		DrawDebugLine(GetWorld(), Start, End, FColor::Blue, false, -1.0f, 0, 2.0f);
+		GridLines->DrawLine(Start, End, FColor::Blue, SDPG_World, 2.0f, 0.0f);
 	}
 
 	// Draw horizontal lines
@@ -172,6 +319,146 @@ void AEnvironmentManager::DrawGrid()
 		FVector Start = GetWorldPositionFromGridCell(0, Y);
 		FVector End = GetWorldPositionFromGridCell(GridWidth, Y);
 
-		DrawDebugLine(GetWorld(), Start, End, FColor::Blue, false, -1.0f, 0, 2.0f);
+		GridLines->DrawLine(Start, End, FColor::Blue, SDPG_World, 2.0f, 0.0f);
+	}
+
+	if (LifeSim)
+	{
+		LifeSim->AddDebugDraws(GridWidth + GridHeight + 2);
+	}
+}
+
+void AEnvironmentManager::InitializeSpatialGrids()
+{
+	// Cell (0, 0) of the hashes lines up with cell (0, 0) of the environment grid
+	FoodGrid.Initialize(GetWorldPositionFromGridCell(0, 0), CellSize);
+	PlantGrid.Initialize(GetWorldPositionFromGridCell(0, 0), CellSize);
+	bSpatialGridsInitialized = true;
+}
+
+void AEnvironmentManager::RegisterFood(FSimEntityHandle Food, const FVector& Location)
+{
+	if (!Food.IsSet())
+		return;
+
+	// Food placed in the level can begin play before we do
+	if (!bSpatialGridsInitialized)
+	{
+		InitializeSpatialGrids();
+	}
+
+	if (FoodIndexReaders > 0)
+	{
+		PendingFoodChanges.Add(FPendingFoodChange{ Food, Location, true });
+		return;
+	}
+
+	FoodGrid.Add(Food, Location);
+}
+
+void AEnvironmentManager::UnregisterFood(FSimEntityHandle Food, const FVector& Location)
+{
+	if (!Food.IsSet() || !bSpatialGridsInitialized)
+		return;
+
+	if (FoodIndexReaders > 0)
+	{
+		PendingFoodChanges.Add(FPendingFoodChange{ Food, Location, false });
+		return;
+	}
+
+	FoodGrid.Remove(Food, Location);
+}
+
+void AEnvironmentManager::BeginFoodIndexRead()
+{
+	FoodIndexReaders++;
+}
+
+void AEnvironmentManager::EndFoodIndexRead()
+{
+	check(FoodIndexReaders > 0);
+	FoodIndexReaders--;
+
+	if (FoodIndexReaders > 0)
+		return;
+
+	// Replay in order, so food spawned and eaten during the read cancels out
+	for (const FPendingFoodChange& Change : PendingFoodChanges)
+	{
+		if (Change.bAdd)
+		{
+			FoodGrid.Add(Change.Food, Change.Location);
+		}
+		else
+		{
+			FoodGrid.Remove(Change.Food, Change.Location);
+		}
+	}
+	PendingFoodChanges.Reset();
+}
+
+bool AEnvironmentManager::FindNearestFood(const FVector& Location, float Radius, FSimEntityHandle& OutFood, FVector& OutFoodLocation) const
+{
+	LIFESIM_SCOPE(STAT_LifeSim_FoodQuery);
+	LIFESIM_ALLOC_SCOPE(Food);
+	FFoodQueryScope QueryScope(bTrackFoodQueries, FoodQueryCount, FoodQueryCycles);
+	const TSpatialHashGrid<FSimEntityHandle>::FEntry* Nearest = FoodGrid.FindNearest(Location, Radius);
+	if (!Nearest)
+		return false;
+
+	OutFood = Nearest->Element;
+	OutFoodLocation = Nearest->Location;
+	return true;
+}
+
+FIntPoint AEnvironmentManager::GetFoodCell(const FVector& Location) const
+{
+	return FoodGrid.GetCell(Location);
+}
+
+bool AEnvironmentManager::FindFoodInCell(const FIntPoint& Cell, FSimEntityHandle& OutFood, FVector& OutFoodLocation) const
+{
+	LIFESIM_SCOPE(STAT_LifeSim_FoodQuery);
+	FFoodQueryScope QueryScope(bTrackFoodQueries, FoodQueryCount, FoodQueryCycles);
+	const TArray<TSpatialHashGrid<FSimEntityHandle>::FEntry>* Entries = FoodGrid.GetCellEntries(Cell);
+	if (!Entries || Entries->Num() == 0)
+		return false;
+
+	OutFood = (*Entries)[0].Element;
+	OutFoodLocation = (*Entries)[0].Location;
+	return true;
+}
+
+void AEnvironmentManager::RegisterPlant(FSimEntityHandle Plant, const FVector& Location)
+{
+	if (!Plant.IsSet())
+		return;
+
+	// Plants placed in the level can begin play before we do
+	if (!bSpatialGridsInitialized)
+	{
+		InitializeSpatialGrids();
 	}
-}
\ No newline at end of file
+
+	PlantGrid.Add(Plant, Location);
+}
+
+void AEnvironmentManager::UnregisterPlant(FSimEntityHandle Plant, const FVector& Location)
+{
+	if (!Plant.IsSet() || !bSpatialGridsInitialized)
+		return;
+
+	PlantGrid.Remove(Plant, Location);
+}
+
+void AEnvironmentManager::FindPlantsInRadius(const FVector& Location, float Radius, TLifeSimScratchArray<FSimEntityHandle>& OutPlants) const
+{
+	PlantGrid.QueryRadius(Location, Radius, OutPlants);
+}
+
+void AEnvironmentManager::ConsumeFoodQueryStats(int32& OutQueries, double& OutSeconds)
+{
+	OutQueries = FoodQueryCount.exchange(0, std::memory_order_relaxed);
+	OutSeconds = FPlatformTime::ToSeconds64(FoodQueryCycles.exchange(0, std::memory_order_relaxed));
+}
@@ -2,8 +2,15 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "SpatialHashGrid.h"
+#include "SimEntityHandle.h"
+#include "LifeSimScratch.h"
+#include <atomic>
 #include "EnvironmentManager.generated.h"
 
+class AFoodActor;
+class ULineBatchComponent;
+
 UCLASS()
 class THEMEANINGOFLIFE_API AEnvironmentManager : public AActor
 {
@@ -13,7 +20,9 @@ public:
 	AEnvironmentManager();
 
 protected:
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	virtual void Tick(float DeltaTime) override;
@@ -54,9 +63,42 @@ public:
 
 	// Visualization
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Environment")
-	bool bShowGridLines; // Toggle grid visualization
+	bool bShowGridLines; // Toggle grid visualization, development builds only
+
+	// Food spatial index, keyed on the CellSize grid
+	void RegisterFood(FSimEntityHandle Food, const FVector& Location);
+	void UnregisterFood(FSimEntityHandle Food, const FVector& Location);
+	// While a simulation step reads the food index off the game thread,
+	// registrations are queued and applied when the read ends
+	void BeginFoodIndexRead();
+	void EndFoodIndexRead();
+
+	// Read-only, safe to call from simulation workers between BeginFoodIndexRead and EndFoodIndexRead
+	bool FindNearestFood(const FVector& Location, float Radius, FSimEntityHandle& OutFood, FVector& OutFoodLocation) const;
+	// Food memories are kept per index cell, so checking one is a single lookup
+	FIntPoint GetFoodCell(const FVector& Location) const;
+	bool FindFoodInCell(const FIntPoint& Cell, FSimEntityHandle& OutFood, FVector& OutFoodLocation) const;
+
+	// Plant spatial index, same grid. Plants never move. Game thread only.
+	void RegisterPlant(FSimEntityHandle Plant, const FVector& Location);
+	void UnregisterPlant(FSimEntityHandle Plant, const FVector& Location);
+	void FindPlantsInRadius(const FVector& Location, float Radius, TLifeSimScratchArray<FSimEntityHandle>& OutPlants) const;
+
+	// Food queries made and time spent in them since the last call, for the frame stats.
+	// Only counted while tracking is on, it costs every query a timer read and two atomics.
+	// Set on the game thread while no step is reading the index.
+	void SetTrackFoodQueries(bool bTrack) { bTrackFoodQueries = bTrack; }
+	bool IsTrackingFoodQueries() const { return bTrackFoodQueries; }
+	void ConsumeFoodQueryStats(int32& OutQueries, double& OutSeconds);
+
+	FIntPoint GetGridCellFromWorldPosition(const FVector& Location) const;
+
+	// Spawns at random grid cells, ignoring the player's caps
+	void SpawnPlants(int32 Count);
+	void SpawnOrganisms(int32 Count);
 
 private:
+	void PrewarmPools();
 	void SpawnInitialPlants();
 	void SpawnPlantAtRandomCell();
 
@@ -64,8 +106,35 @@ private:
 	void SpawnOrganismAtRandomCell();
 	FVector GetWorldPositionFromGridCell(int32 X, int32 Y);
 	bool IsWithinBounds(FVector Location);
-	void DrawGrid();
+	// Grid lines stay in a line batch and are only redrawn when the grid changes
+	void UpdateGridLines();
+	void InitializeSpatialGrids();
+
+	UPROPERTY()
+	class ULifeSimSubsystem* LifeSim;
+
+	UPROPERTY()
+	ULineBatchComponent* GridLines;
+
+	// Settings the grid lines were drawn with
+	uint32 GridLinesHash;
+
+	TSpatialHashGrid<FSimEntityHandle> FoodGrid;
+	TSpatialHashGrid<FSimEntityHandle> PlantGrid;
+	bool bSpatialGridsInitialized;
+
+	struct FPendingFoodChange
+	{
+		FSimEntityHandle Food;
+		FVector Location;
+		bool bAdd;
+	};
+
+	int32 FoodIndexReaders;
+	TArray<FPendingFoodChange> PendingFoodChanges;
 
-	TArray<AActor*> SpawnedOrganisms;
-	TArray<AActor*> SpawnedPlants;
+	// Queries come from simulation workers
+	bool bTrackFoodQueries;
+	mutable std::atomic<int32> FoodQueryCount;
+	mutable std::atomic<uint64> FoodQueryCycles;
 };
@@ -2,10 +2,19 @@
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/Material.h"
+#include "EnvironmentManager.h"
+#include "LifeSimSubsystem.h"
+#include "PlantActor.h"
+#include "LifeSimRenderer.h"
+#include "LifeSimMemory.h"
+
+// Magenta
+static const FLinearColor FoodColor(0.69f, 0.15f, 0.55f, 1.0f);
 
 AFoodActor::AFoodActor()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+	// Food just sits there until it is eaten
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	// Create mesh component
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
@@ -19,34 +28,125 @@ AFoodActor::AFoodActor()
 		MeshComponent->SetWorldScale3D(FVector(0.3f, 0.3f, 0.3f)); // Make it smaller
 	}
 
-	// Load a basic material from the engine
+	// Load a basic material from the engine, tinted in BeginPlay when not instanced
 	static ConstructorHelpers::FObjectFinder<UMaterial> Material(TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
 	if (Material.Succeeded())
 	{
-		UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(Material.Object, this);
-		if (DynMaterial)
-		{
-			// Set color to magenta
-			DynMaterial->SetVectorParameterValue(FName("Color"), FLinearColor(0.69f, 0.15f, 0.55f, 1.0f));
-			MeshComponent->SetMaterial(0, DynMaterial);
-		}
+		MeshComponent->SetMaterial(0, Material.Object);
 	}
 
 	// Default energy value
 	EnergyValue = 40.0f;
+
+	LifeSim = nullptr;
+	Renderer = nullptr;
+	RenderInstance = INDEX_NONE;
+	RegisteredLocation = FVector::ZeroVector;
 }
 
 // Called when the game starts or when spawned
 void AFoodActor::BeginPlay()
 {
+	LIFESIM_LLM_SCOPE(Food);
 	Super::BeginPlay();
 	
 	// UE_LOG(LogTemp, Warning, TEXT("Food spawned with %f energy value"), EnergyValue);
+
+	LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+	Renderer = LifeSim ? LifeSim->GetRenderer() : nullptr;
+
+	if (Renderer)
+	{
+		MeshComponent->SetHiddenInGame(true);
+	}
+	else if (ULifeSimSubsystem::IsHeadless())
+	{
+		// Nothing is drawn, keep the shared material
+	}
+	else if (UMaterialInstanceDynamic* DynMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamic(0))
+	{
+		DynMaterial->SetVectorParameterValue(FName("Color"), FoodColor);
+	}
+
+	JoinSimulation();
+}
+
+void AFoodActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Parked food has already left
+	LeaveSimulation();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFoodActor::OnAcquiredFromPool()
+{
+	EnergyValue = GetClass()->GetDefaultObject<AFoodActor>()->EnergyValue;
+	OwnerPlant.Reset();
+
+	JoinSimulation();
+}
+
+void AFoodActor::OnReleasedToPool()
+{
+	LeaveSimulation();
+}
+
+void AFoodActor::JoinSimulation()
+{
+	if (Renderer)
+	{
+		RenderInstance = Renderer->AddInstance(ESimEntityType::Food, MeshComponent->GetComponentTransform(), FoodColor);
+	}
+
+	if (!LifeSim)
+		return;
+
+	SimHandle = LifeSim->RegisterEntity(this, ESimEntityType::Food);
+
+	// Food never moves while in play, so it only has to be indexed once
+	if (AEnvironmentManager* Environment = LifeSim->GetContext().Environment)
+	{
+		RegisteredLocation = GetActorLocation();
+		Environment->RegisterFood(SimHandle, RegisteredLocation);
+	}
+}
+
+void AFoodActor::LeaveSimulation()
+{
+	if (LifeSim && SimHandle.IsSet())
+	{
+		if (APlantActor* Plant = LifeSim->Resolve<APlantActor>(OwnerPlant))
+		{
+			Plant->OnFoodRemoved();
+		}
+		OwnerPlant.Reset();
+
+		if (AEnvironmentManager* Environment = LifeSim->GetContext().Environment)
+		{
+			Environment->UnregisterFood(SimHandle, RegisteredLocation);
+		}
+
+		LifeSim->UnregisterEntity(SimHandle);
+		SimHandle.Reset();
+	}
+
+	if (Renderer && RenderInstance != INDEX_NONE)
+	{
+		Renderer->RemoveInstance(ESimEntityType::Food, RenderInstance);
+		RenderInstance = INDEX_NONE;
+	}
 }
 
 void AFoodActor::Consume()
 {
 	// UE_LOG(LogTemp, Warning, TEXT("Food consumed!"));
+	// Parked for the next plant that produces food
+	if (LifeSim)
+	{
+		LifeSim->ReleaseActor(this);
+		return;
+	}
 	Destroy();
 }
 
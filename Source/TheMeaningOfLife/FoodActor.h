@@ -2,10 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "SimEntityHandle.h"
+#include "PooledActor.h"
 #include "FoodActor.generated.h"
 
 UCLASS()
-class THEMEANINGOFLIFE_API AFoodActor : public AActor
+class THEMEANINGOFLIFE_API AFoodActor : public AActor, public IPooledActor
 {
 	GENERATED_BODY()
 	
@@ -14,6 +16,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// How much energy this food provides
@@ -26,4 +29,36 @@ public:
 
 	// Called when an organism consumes this food
 	void Consume();
+
+	FSimEntityHandle GetSimHandle() const { return SimHandle; }
+
+	// Plant that spawned this food, told when the food is eaten or goes away
+	void SetOwnerPlant(FSimEntityHandle InOwnerPlant) { OwnerPlant = InOwnerPlant; }
+
+	// Pooled actor interface implementation
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
+private:
+	// Registry entry, food index entry and render instance while in play
+	void JoinSimulation();
+	void LeaveSimulation();
+
+	// Registry entry, valid between BeginPlay and EndPlay
+	UPROPERTY()
+	class ULifeSimSubsystem* LifeSim;
+
+	FSimEntityHandle SimHandle;
+
+	// Stale once the plant itself is gone
+	FSimEntityHandle OwnerPlant;
+
+	// Where we were added to the environment's food index
+	FVector RegisteredLocation;
+
+	// Instance drawn in place of MeshComponent, unset when the food draws itself
+	UPROPERTY()
+	class ALifeSimRenderer* Renderer;
+
+	int32 RenderInstance;
 };
@@ -0,0 +1,90 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "LifeSimSubsystem.h"
+#include "LifeSimAllocTracker.h"
+#include "EnvironmentManager.h"
+#include "OrganismActor.h"
+#include "PlantActor.h"
+#include "FoodActor.h"
+#include "ResourceComponent.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && LIFESIM_ALLOC_TRACKING
+
+// Same check as the headless commandlet's -VerifyNoAllocs, on a small world
+// built from the native actor classes so it needs no map. Installing the
+// tracker wraps GMalloc for the rest of the session.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLifeSimSteadyStateAllocTest, "TheMeaningOfLife.LifeSim.SteadyStateDoesNotAllocate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLifeSimSteadyStateAllocTest::RunTest(const FString& Parameters)
+{
+	FLifeSimAllocTracker::Install();
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+
+	ULifeSimSubsystem* LifeSim = World->GetSubsystem<ULifeSimSubsystem>();
+	if (!TestNotNull(TEXT("LifeSim subsystem"), LifeSim))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	AEnvironmentManager* Environment = World->SpawnActor<AEnvironmentManager>();
+	Environment->bShowGridLines = false;
+	Environment->OrganismActorClass = AOrganismActor::StaticClass();
+	Environment->PlantActorClass = APlantActor::StaticClass();
+	Environment->FoodActorClass = AFoodActor::StaticClass();
+
+	// Resources normally live on the player controller, as in the commandlet
+	AActor* ResourceHolder = World->SpawnActor<AActor>();
+	UResourceComponent* Resources = NewObject<UResourceComponent>(ResourceHolder, TEXT("Resources"));
+	ResourceHolder->AddInstanceComponent(Resources);
+	Resources->RegisterComponent();
+
+	World->BeginPlay();
+	LifeSim->SetSimulationSpeed(1.0f);
+
+	// Pools, channel buckets and command buffers settle in the first seconds
+	const float DeltaTime = ULifeSimSubsystem::GetFixedDeltaTime();
+	while (LifeSim->GetSimulationTime() < 10.0)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+		GFrameCounter++;
+	}
+
+	for (int32 Frame = 0; Frame < 120; Frame++)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+		GFrameCounter++;
+
+		const FLifeSimFrameStats& Stats = LifeSim->GetLastFrameStats();
+		if (Stats.GetSimulationHeapAllocs() > 0)
+		{
+			for (int32 Index = 1; Index < (int32)ELifeSimAllocScope::Count; Index++)
+			{
+				if (Stats.HeapAllocs[Index] > 0)
+				{
+					AddError(FString::Printf(TEXT("Frame %llu: %d heap allocations in %s"),
+						Stats.FrameNumber, Stats.HeapAllocs[Index], FLifeSimAllocTracker::GetScopeName((ELifeSimAllocScope)Index)));
+				}
+			}
+			break;
+		}
+	}
+
+	LifeSim->WaitForSimulationStep();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return !HasAnyErrors();
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "LifeSimAllocTracker.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include <atomic>
+
+#if LIFESIM_ALLOC_TRACKING
+
+// Which scope this thread is in
+static thread_local ELifeSimAllocScope GLifeSimAllocScope = ELifeSimAllocScope::None;
+
+static std::atomic<int32> GLifeSimAllocCounts[(int32)ELifeSimAllocScope::Count];
+static bool GLifeSimAllocTrackingInstalled = false;
+
+// Forwards everything to the real allocator and counts new blocks made inside
+// a scope. Blocks the inner allocator handed out before the swap are freed by
+// it as usual, so installing late is safe.
+class FLifeSimCountingMalloc final : public FMalloc
+{
+public:
+	explicit FLifeSimCountingMalloc(FMalloc* InInner)
+		: Inner(InInner)
+	{
+	}
+
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->Malloc(Size, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+	{
+		CountAllocation();
+		return Inner->TryMalloc(Size, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+	{
+		// Shrinking to nothing is a free
+		if (Size > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->Realloc(Original, Size, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+	{
+		if (Size > 0)
+		{
+			CountAllocation();
+		}
+		return Inner->TryRealloc(Original, Size, Alignment);
+	}
+
+	virtual void Free(void* Original) override { Inner->Free(Original); }
+	virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+	virtual void UpdateStats() override { Inner->UpdateStats(); }
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+	virtual void OnMallocInitialized() override { Inner->OnMallocInitialized(); }
+	virtual void OnPreFork() override { Inner->OnPreFork(); }
+	virtual void OnPostFork() override { Inner->OnPostFork(); }
+
+private:
+	void CountAllocation()
+	{
+		if (GLifeSimAllocScope != ELifeSimAllocScope::None)
+		{
+			GLifeSimAllocCounts[(int32)GLifeSimAllocScope].fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	FMalloc* Inner;
+};
+
+FLifeSimAllocScope::FLifeSimAllocScope(ELifeSimAllocScope Scope)
+	: Previous(GLifeSimAllocScope)
+{
+	GLifeSimAllocScope = Scope;
+}
+
+FLifeSimAllocScope::~FLifeSimAllocScope()
+{
+	GLifeSimAllocScope = Previous;
+}
+
+#endif
+
+void FLifeSimAllocTracker::InstallIfRequested()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("LifeSimAllocTracking")))
+	{
+		Install();
+	}
+}
+
+void FLifeSimAllocTracker::Install()
+{
+#if LIFESIM_ALLOC_TRACKING
+	check(IsInGameThread());
+
+	if (GLifeSimAllocTrackingInstalled)
+		return;
+
+	// Never removed, other threads may be inside it at any time
+	GMalloc = new FLifeSimCountingMalloc(GMalloc);
+	GLifeSimAllocTrackingInstalled = true;
+
+	UE_LOG(LogTemp, Warning, TEXT("LifeSim heap allocation tracking is on, every allocation now goes through a counting proxy"));
+#endif
+}
+
+bool FLifeSimAllocTracker::IsEnabled()
+{
+#if LIFESIM_ALLOC_TRACKING
+	return GLifeSimAllocTrackingInstalled;
+#else
+	return false;
+#endif
+}
+
+void FLifeSimAllocTracker::ConsumeCounts(int32 (&OutCounts)[(int32)ELifeSimAllocScope::Count])
+{
+	for (int32 Index = 0; Index < (int32)ELifeSimAllocScope::Count; Index++)
+	{
+#if LIFESIM_ALLOC_TRACKING
+		OutCounts[Index] = GLifeSimAllocCounts[Index].exchange(0, std::memory_order_relaxed);
+#else
+		OutCounts[Index] = 0;
+#endif
+	}
+}
+
+const TCHAR* FLifeSimAllocTracker::GetScopeName(ELifeSimAllocScope Scope)
+{
+	switch (Scope)
+	{
+	case ELifeSimAllocScope::Organisms: return TEXT("Organisms");
+	case ELifeSimAllocScope::Food: return TEXT("Food");
+	case ELifeSimAllocScope::Plants: return TEXT("Plants");
+	case ELifeSimAllocScope::Resources: return TEXT("Resources");
+	case ELifeSimAllocScope::Render: return TEXT("Render");
+	case ELifeSimAllocScope::UI: return TEXT("UI");
+	default: return TEXT("None");
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Heap allocation counting per simulation area, for checking that steady-state
+// frames do not allocate. Off unless the game runs with -LifeSimAllocTracking,
+// which wraps GMalloc in a counting proxy. Compiled out of shipping builds.
+//
+// Scopes cover the simulation's own work: its containers, the entities it
+// creates and what each organism or chunk does on whichever thread runs it.
+// Handing work to the task system (ParallelFor, the Mass executor and
+// ParallelForEachEntityChunk) is left outside, on both organism backends.
+// Those allocations belong to the engine and no pooling on our side removes
+// them, so the callback opens its own scope instead.
+#define LIFESIM_ALLOC_TRACKING !UE_BUILD_SHIPPING
+
+enum class ELifeSimAllocScope : uint8
+{
+	None,
+	Organisms,
+	Food,
+	Plants,
+	Resources,
+	Render,
+	UI,
+	Count
+};
+
+class FLifeSimAllocTracker
+{
+public:
+	// Wraps GMalloc once. Game thread, safe to call repeatedly.
+	static void Install();
+
+	// Install, if the command line asks for it
+	static void InstallIfRequested();
+	static bool IsEnabled();
+
+	// Allocations made inside each scope since the last call, on any thread
+	static void ConsumeCounts(int32 (&OutCounts)[(int32)ELifeSimAllocScope::Count]);
+
+	static const TCHAR* GetScopeName(ELifeSimAllocScope Scope);
+};
+
+#if LIFESIM_ALLOC_TRACKING
+
+// Attributes this thread's allocations to Scope until it goes out of scope
+struct FLifeSimAllocScope
+{
+	explicit FLifeSimAllocScope(ELifeSimAllocScope Scope);
+	~FLifeSimAllocScope();
+
+private:
+	ELifeSimAllocScope Previous;
+};
+
+#define LIFESIM_ALLOC_SCOPE(Scope) FLifeSimAllocScope PREPROCESSOR_JOIN(LifeSimAllocScope, __LINE__)(ELifeSimAllocScope::Scope)
+
+#else
+
+#define LIFESIM_ALLOC_SCOPE(Scope)
+
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimEntityHandle.h"
+
+// How an organism picked its movement target this step (used for debug drawing)
+enum class EOrganismSeekMode : uint8
+{
+	None,
+	Memory,
+	Sight
+};
+
+// Time each part of an organism step covers, from FLifeSimScheduler.
+// Zero means that part does not run for this organism this step.
+struct FOrganismStepDeltas
+{
+	float Movement = 0.0f;
+	float Sensing = 0.0f;
+
+	// Simulation time at the end of the step, food memories are stamped with it
+	float Time = 0.0f;
+};
+
+// Structural changes one organism wants to make during a simulation step.
+// Recorded by the organism on a worker thread and applied on the game thread
+// at the sync point, in registry order, so the outcome does not depend on
+// thread scheduling.
+struct FOrganismCommands
+{
+	bool bDie = false;
+
+	// Food claimed this step. If several organisms claim the same food, the
+	// first one in registry order eats it and the others get nothing.
+	FSimEntityHandle FoodToEat;
+	FVector FoodLocation = FVector::ZeroVector;
+
+	// Offspring request. The population cap is checked when it is applied.
+	bool bReproduce = false;
+	FVector OffspringDirection = FVector::ZeroVector;
+
+	bool bMoved = false;
+	FVector NewLocation = FVector::ZeroVector;
+
+	// Debug visualization
+	bool bSeeking = false;
+	EOrganismSeekMode SeekMode = EOrganismSeekMode::None;
+	FVector SeekTarget = FVector::ZeroVector;
+
+	void Reset()
+	{
+		*this = FOrganismCommands();
+	}
+};
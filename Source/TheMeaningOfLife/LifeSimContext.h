@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UResourceComponent;
+class AEnvironmentManager;
+
+// World-level objects every simulation actor needs, resolved once per world
+// by ULifeSimSubsystem. Actors keep a pointer to it instead of looking these
+// up through the player controller or an actor scan.
+struct FLifeSimContext
+{
+	UResourceComponent* Resources = nullptr;
+	AEnvironmentManager* Environment = nullptr;
+
+	// XY extent of the environment grid, derived from GridWidth/GridHeight/CellSize
+	FBox2D WorldBounds = FBox2D(ForceInit);
+
+	bool HasWorldBounds() const
+	{
+		return WorldBounds.bIsValid;
+	}
+};
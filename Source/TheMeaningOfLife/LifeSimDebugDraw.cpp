@@ -0,0 +1,101 @@
+#include "LifeSimDebugDraw.h"
+
+#if ENABLE_DRAW_DEBUG
+
+#include "ConvexVolume.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "SceneManagement.h"
+#include "LifeSimSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarLifeSimDebugDetectionRadius(
+	TEXT("lifesim.Debug.DetectionRadius"),
+	false,
+	TEXT("Draw how far a food seeking organism can see."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimDebugSeekTarget(
+	TEXT("lifesim.Debug.SeekTarget"),
+	false,
+	TEXT("Draw a green line to the food an organism has in sight."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimDebugMemoryTarget(
+	TEXT("lifesim.Debug.MemoryTarget"),
+	false,
+	TEXT("Draw a cyan line to the remembered food an organism is heading for."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimDebugAllVisible(
+	TEXT("lifesim.Debug.AllVisible"),
+	false,
+	TEXT("Draw the lifesim.Debug overlays for every organism in view instead of only the selected one."));
+
+namespace
+{
+	// Camera frustum, worked out once per frame and shared by every organism
+	struct FDebugViewFrustum
+	{
+		FConvexVolume Volume;
+		const UWorld* World = nullptr;
+		uint64 Frame = MAX_uint64;
+		bool bValid = false;
+	};
+
+	const FDebugViewFrustum& GetViewFrustum(const UWorld* World)
+	{
+		static FDebugViewFrustum Frustum;
+		if (Frustum.World == World && Frustum.Frame == GFrameCounter)
+			return Frustum;
+
+		Frustum.World = World;
+		Frustum.Frame = GFrameCounter;
+		Frustum.bValid = false;
+
+		const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		if (PlayerController && PlayerController->PlayerCameraManager)
+		{
+			FMatrix ViewMatrix, ProjectionMatrix, ViewProjectionMatrix;
+			UGameplayStatics::GetViewProjectionMatrix(PlayerController->PlayerCameraManager->GetCameraCacheView(),
+				ViewMatrix, ProjectionMatrix, ViewProjectionMatrix);
+			GetViewFrustumBounds(Frustum.Volume, ViewProjectionMatrix, false);
+			Frustum.bValid = true;
+		}
+		return Frustum;
+	}
+}
+
+bool FLifeSimDebugDraw::IsEnabled(ELifeSimDebugCategory Category)
+{
+	switch (Category)
+	{
+	case ELifeSimDebugCategory::DetectionRadius: return CVarLifeSimDebugDetectionRadius.GetValueOnGameThread();
+	case ELifeSimDebugCategory::SeekTarget: return CVarLifeSimDebugSeekTarget.GetValueOnGameThread();
+	case ELifeSimDebugCategory::MemoryTarget: return CVarLifeSimDebugMemoryTarget.GetValueOnGameThread();
+	default: return false;
+	}
+}
+
+bool FLifeSimDebugDraw::IsAnyEnabled()
+{
+	return IsEnabled(ELifeSimDebugCategory::DetectionRadius)
+		|| IsEnabled(ELifeSimDebugCategory::SeekTarget)
+		|| IsEnabled(ELifeSimDebugCategory::MemoryTarget);
+}
+
+bool FLifeSimDebugDraw::ShouldDraw(const AActor& Actor, bool bSelected, float Radius)
+{
+	if (ULifeSimSubsystem::IsHeadless() || !IsAnyEnabled())
+		return false;
+
+	if (bSelected)
+		return true;
+
+	if (!CVarLifeSimDebugAllVisible.GetValueOnGameThread())
+		return false;
+
+	const FDebugViewFrustum& Frustum = GetViewFrustum(Actor.GetWorld());
+	return Frustum.bValid && Frustum.Volume.IntersectSphere(Actor.GetActorLocation(), Radius);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DrawDebugHelpers.h"
+
+class AActor;
+
+// Per-entity debug overlays, each category off until its lifesim.Debug.* cvar
+// turns it on. Only the selected organism draws, or every organism inside the
+// camera frustum with lifesim.Debug.AllVisible. Static geometry such as the
+// grid does not go through here, it is built once into a line batch.
+// Compiled out along with DrawDebugHelpers (ENABLE_DRAW_DEBUG).
+enum class ELifeSimDebugCategory : uint8
+{
+	DetectionRadius,
+	SeekTarget,
+	MemoryTarget
+};
+
+#if ENABLE_DRAW_DEBUG
+
+class FLifeSimDebugDraw
+{
+public:
+	static bool IsEnabled(ELifeSimDebugCategory Category);
+	static bool IsAnyEnabled();
+
+	// Selected, or in view when lifesim.Debug.AllVisible is on. Game thread only.
+	static bool ShouldDraw(const AActor& Actor, bool bSelected, float Radius);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LifeSimAllocTracker.h"
+
+// Where one frame's time went, filled in by ULifeSimSubsystem as the frame runs.
+// Times are in milliseconds of the thread they ran on.
+struct FLifeSimFrameStats
+{
+	uint64 FrameNumber = 0;
+
+	// Wall time since the previous frame's simulation tick
+	float FrameMs = 0.0f;
+
+	// Fixed steps run this frame
+	int32 NumSteps = 0;
+
+	// Game thread: applying and launching organism steps, plus the Mass backend
+	float OrganismMs = 0.0f;
+
+	// Simulation thread: stepping organisms. Overlaps the game thread, so it is
+	// not part of FrameMs unless the game thread had to wait for it.
+	float OrganismThreadMs = 0.0f;
+
+	// Food index lookups, summed over every thread that made one. Only counted
+	// while something shows them, otherwise bFoodQueriesTracked is false and both stay 0.
+	float FoodQueryMs = 0.0f;
+	int32 FoodQueries = 0;
+	bool bFoodQueriesTracked = false;
+
+	float PlantMs = 0.0f;
+	float ResourceMs = 0.0f;
+
+	// Instance updates sent to the renderer
+	float RenderMs = 0.0f;
+
+	// Reported by the player controller
+	float UiMs = 0.0f;
+
+	// DrawDebug* calls made for the simulation
+	int32 DebugDraws = 0;
+
+	// Entities registered and unregistered, pooled ones included
+	int32 Spawns = 0;
+	int32 Destroys = 0;
+
+	// Heap allocations per area, only counted with -LifeSimAllocTracking
+	int32 HeapAllocs[(int32)ELifeSimAllocScope::Count] = {};
+
+	// Allocations in the simulation itself, UI left out
+	int32 GetSimulationHeapAllocs() const
+	{
+		return HeapAllocs[(int32)ELifeSimAllocScope::Organisms] + HeapAllocs[(int32)ELifeSimAllocScope::Food]
+			+ HeapAllocs[(int32)ELifeSimAllocScope::Plants] + HeapAllocs[(int32)ELifeSimAllocScope::Resources]
+			+ HeapAllocs[(int32)ELifeSimAllocScope::Render];
+	}
+
+	// Population at the end of the frame
+	int32 Organisms = 0;
+	int32 Plants = 0;
+	int32 Food = 0;
+};
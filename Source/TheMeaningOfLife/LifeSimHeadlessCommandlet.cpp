@@ -0,0 +1,320 @@
+#include "LifeSimHeadlessCommandlet.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "LifeSimSubsystem.h"
+#include "EnvironmentManager.h"
+#include "ResourceComponent.h"
+#include "LifeSimAllocTracker.h"
+#include "LifeSimMemory.h"
+
+// Running totals over the whole run, sampled every tick
+struct FHeadlessRunStats
+{
+	int32 MinOrganisms = MAX_int32;
+	int32 MaxOrganisms = 0;
+	int32 MinPlants = MAX_int32;
+	int32 MaxPlants = 0;
+	int32 MaxFood = 0;
+	double OrganismSeconds = 0.0; // Organism count integrated over simulated time
+	double ExtinctionTime = -1.0; // When the last organism died, if it did
+
+	void Sample(const ULifeSimSubsystem& LifeSim, double SimulatedDelta)
+	{
+		const int32 Organisms = LifeSim.GetCount(ESimEntityType::Organism);
+		const int32 Plants = LifeSim.GetCount(ESimEntityType::Plant);
+
+		MinOrganisms = FMath::Min(MinOrganisms, Organisms);
+		MaxOrganisms = FMath::Max(MaxOrganisms, Organisms);
+		MinPlants = FMath::Min(MinPlants, Plants);
+		MaxPlants = FMath::Max(MaxPlants, Plants);
+		MaxFood = FMath::Max(MaxFood, LifeSim.GetCount(ESimEntityType::Food));
+		OrganismSeconds += Organisms * SimulatedDelta;
+
+		if (Organisms == 0 && ExtinctionTime < 0.0)
+		{
+			ExtinctionTime = LifeSim.GetSimulationTime();
+		}
+	}
+};
+
+ULifeSimHeadlessCommandlet::ULifeSimHeadlessCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 ULifeSimHeadlessCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> CommandLineSettings;
+	ParseCommandLine(*Params, Tokens, Switches, CommandLineSettings);
+
+	// Scenario first so the command line can override single values
+	TMap<FString, FString> Settings;
+	if (const FString* ScenarioPath = CommandLineSettings.Find(TEXT("Scenario")))
+	{
+		FConfigFile Scenario;
+		Scenario.Read(FPaths::ConvertRelativePathToFull(*ScenarioPath));
+
+		const FConfigSection* Section = Scenario.FindSection(TEXT("Scenario"));
+		if (!Section)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Headless: no [Scenario] section in %s"), **ScenarioPath);
+			return 1;
+		}
+
+		for (const auto& Pair : *Section)
+		{
+			Settings.Add(Pair.Key.ToString(), Pair.Value.GetValue());
+		}
+	}
+	Settings.Append(CommandLineSettings);
+
+	const FString MapName = Settings.FindRef(TEXT("Map")).IsEmpty() ? FString(TEXT("/Game/Maps/TestMap")) : Settings.FindRef(TEXT("Map"));
+	const double Duration = Settings.Contains(TEXT("Duration")) ? FCString::Atod(*Settings[TEXT("Duration")]) : 600.0;
+	const bool bBenchmark = Settings.Contains(TEXT("Benchmark"));
+	const int32 StepsPerTick = Settings.Contains(TEXT("StepsPerTick")) ? FMath::Max(FCString::Atoi(*Settings[TEXT("StepsPerTick")]), 1) : (bBenchmark ? 1 : 16);
+
+	if (const FString* Seed = Settings.Find(TEXT("Seed")))
+	{
+		FMath::RandInit(FCString::Atoi(**Seed));
+		FMath::SRandInit(FCString::Atoi(**Seed));
+	}
+
+	// Installed before the world exists so the whole run goes through it
+	const bool bVerifyNoAllocs = Switches.Contains(TEXT("VerifyNoAllocs"));
+	const double VerifyWarmup = Settings.Contains(TEXT("VerifyWarmup")) ? FCString::Atod(*Settings[TEXT("VerifyWarmup")]) : 10.0;
+	if (bVerifyNoAllocs)
+	{
+		FLifeSimAllocTracker::Install();
+		if (!FLifeSimAllocTracker::IsEnabled())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Headless: allocation tracking is not available in this build"));
+			return 1;
+		}
+	}
+
+	UWorld* World = CreateGameWorld(MapName);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Headless: could not load %s"), *MapName);
+		return 1;
+	}
+
+	ULifeSimSubsystem* LifeSim = World->GetSubsystem<ULifeSimSubsystem>();
+	if (!LifeSim)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Headless: %s has no simulation"), *MapName);
+		DestroyGameWorld(World);
+		return 1;
+	}
+
+	ApplyOverrides(World, Settings);
+
+	// The player's resources normally live on the player controller, which
+	// needs a viewport. A bare actor carries them instead so caps and income still apply.
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	AActor* ResourceHolder = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	UResourceComponent* Resources = NewObject<UResourceComponent>(ResourceHolder, TEXT("Resources"));
+	ResourceHolder->AddInstanceComponent(Resources);
+	Resources->RegisterComponent();
+
+	World->BeginPlay();
+
+	if (bBenchmark)
+	{
+		TArray<FString> CountStrings;
+		Settings[TEXT("Benchmark")].ParseIntoArray(CountStrings, TEXT(","));
+
+		TArray<int32> OrganismCounts;
+		for (const FString& Count : CountStrings)
+		{
+			OrganismCounts.Add(FCString::Atoi(*Count));
+		}
+		LifeSim->StartBenchmark(OrganismCounts);
+
+		UE_LOG(LogTemp, Display, TEXT("Headless: benchmarking %s, %d steps per tick"), *MapName, StepsPerTick);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("Headless: running %s for %.0f simulated seconds, %d steps per tick"),
+			*MapName, Duration, StepsPerTick);
+	}
+
+	// Every tick is paid out in whole fixed steps at speed 1
+	const float TickDeltaTime = ULifeSimSubsystem::GetFixedDeltaTime() * StepsPerTick;
+	LifeSim->SetSimulationSpeed(1.0f);
+
+	FHeadlessRunStats Stats;
+	int32 AllocatingFrames = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	double LastProgressTime = StartTime;
+	double LastSimulationTime = 0.0;
+
+	while ((bBenchmark ? LifeSim->IsBenchmarkRunning() : LifeSim->GetSimulationTime() < Duration) && !IsEngineExitRequested())
+	{
+		World->Tick(LEVELTICK_All, TickDeltaTime);
+		GFrameCounter++;
+
+		const double SimulationTime = LifeSim->GetSimulationTime();
+		Stats.Sample(*LifeSim, SimulationTime - LastSimulationTime);
+		LastSimulationTime = SimulationTime;
+
+		if (bVerifyNoAllocs && SimulationTime >= VerifyWarmup)
+		{
+			CheckFrameAllocations(LifeSim->GetLastFrameStats(), AllocatingFrames);
+		}
+
+		// Pooled actors make garbage rare, but long runs still produce some
+		if (GFrameCounter % 1000 == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastProgressTime > 10.0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Headless: %.0f / %.0f s, %d organisms, %d plants"),
+				SimulationTime, Duration, LifeSim->GetCount(ESimEntityType::Organism), LifeSim->GetCount(ESimEntityType::Plant));
+			LastProgressTime = Now;
+		}
+	}
+
+	LifeSim->WaitForSimulationStep();
+	const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+	const double SimulatedSeconds = LifeSim->GetSimulationTime();
+
+	UE_LOG(LogTemp, Display, TEXT("===== LifeSim headless summary ====="));
+	UE_LOG(LogTemp, Display, TEXT("Map:            %s"), *MapName);
+	UE_LOG(LogTemp, Display, TEXT("Simulated:      %.1f s in %llu steps"), SimulatedSeconds, LifeSim->GetStepCount());
+	UE_LOG(LogTemp, Display, TEXT("Wall clock:     %.1f s"), WallSeconds);
+	UE_LOG(LogTemp, Display, TEXT("Speed:          %.1f simulated s per wall s"), WallSeconds > 0.0 ? SimulatedSeconds / WallSeconds : 0.0);
+	UE_LOG(LogTemp, Display, TEXT("Organisms:      %d at end, min %d, max %d, mean %.1f"),
+		LifeSim->GetCount(ESimEntityType::Organism), Stats.MinOrganisms, Stats.MaxOrganisms,
+		SimulatedSeconds > 0.0 ? Stats.OrganismSeconds / SimulatedSeconds : 0.0);
+	if (Stats.ExtinctionTime >= 0.0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Extinct at:     %.1f s"), Stats.ExtinctionTime);
+	}
+	UE_LOG(LogTemp, Display, TEXT("Plants:         %d at end, min %d, max %d"),
+		LifeSim->GetCount(ESimEntityType::Plant), Stats.MinPlants, Stats.MaxPlants);
+	UE_LOG(LogTemp, Display, TEXT("Food:           %d at end, max %d"),
+		LifeSim->GetCount(ESimEntityType::Food), Stats.MaxFood);
+	UE_LOG(LogTemp, Display, TEXT("Resources:      energy %.1f/%.1f, water %.1f/%.1f, life essence %d/%d"),
+		Resources->Energy, Resources->MaxEnergy, Resources->Water, Resources->MaxWater,
+		Resources->LifeEssence, Resources->MaxLifeEssence);
+
+	// Measured on the final population, before the world goes away
+	const bool bWithinMemBudget = !Switches.Contains(TEXT("MemReport")) || FLifeSimMemoryReport::Report(World);
+
+	DestroyGameWorld(World);
+
+	if (!bWithinMemBudget)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Headless: entities are over their memory budget"));
+		return 1;
+	}
+
+	if (bVerifyNoAllocs)
+	{
+		if (AllocatingFrames > 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Headless: %d steady-state frames allocated on the heap"), AllocatingFrames);
+			return 1;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Headless: no steady-state frame allocated on the heap"));
+	}
+	return 0;
+}
+
+void ULifeSimHeadlessCommandlet::CheckFrameAllocations(const FLifeSimFrameStats& Frame, int32& AllocatingFrames)
+{
+	if (Frame.GetSimulationHeapAllocs() == 0)
+		return;
+
+	// The first few are enough to go on, the rest only count
+	if (AllocatingFrames++ < 10)
+	{
+		FString Breakdown;
+		for (int32 Index = 1; Index < (int32)ELifeSimAllocScope::Count; Index++)
+		{
+			if (Frame.HeapAllocs[Index] > 0)
+			{
+				Breakdown += FString::Printf(TEXT(" %s %d"), FLifeSimAllocTracker::GetScopeName((ELifeSimAllocScope)Index), Frame.HeapAllocs[Index]);
+			}
+		}
+		UE_LOG(LogTemp, Warning, TEXT("Headless: frame %llu allocated:%s"), Frame.FrameNumber, *Breakdown);
+	}
+}
+
+UWorld* ULifeSimHeadlessCommandlet::CreateGameWorld(const FString& MapName)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (!World)
+		return nullptr;
+
+	// Subsystems only come up for game worlds
+	World->WorldType = EWorldType::Game;
+	World->AddToRoot();
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	World->InitWorld(UWorld::InitializationValues()
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.SetTransactional(false));
+	World->UpdateWorldComponents(true, false);
+
+	FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	return World;
+}
+
+void ULifeSimHeadlessCommandlet::DestroyGameWorld(UWorld* World)
+{
+	World->CleanupWorld();
+	GEngine->DestroyWorldContext(World);
+	World->RemoveFromRoot();
+}
+
+void ULifeSimHeadlessCommandlet::ApplyOverrides(UWorld* World, const TMap<FString, FString>& Settings)
+{
+	for (TActorIterator<AEnvironmentManager> It(World); It; ++It)
+	{
+		AEnvironmentManager* Environment = *It;
+
+		// Nothing would see it anyway
+		Environment->bShowGridLines = false;
+
+		if (const FString* Value = Settings.Find(TEXT("GridWidth")))
+			Environment->GridWidth = FCString::Atoi(**Value);
+		if (const FString* Value = Settings.Find(TEXT("GridHeight")))
+			Environment->GridHeight = FCString::Atoi(**Value);
+		if (const FString* Value = Settings.Find(TEXT("InitialPlantCount")))
+			Environment->InitialPlantCount = FCString::Atoi(**Value);
+		if (const FString* Value = Settings.Find(TEXT("InitialOrganismCount")))
+			Environment->InitialOrganismCount = FCString::Atoi(**Value);
+
+		// Registered from PostInitializeComponents with the map's grid, the world bounds have to follow the new size
+		if (ULifeSimSubsystem* LifeSim = World->GetSubsystem<ULifeSimSubsystem>())
+		{
+			LifeSim->RegisterEnvironment(Environment);
+		}
+	}
+}
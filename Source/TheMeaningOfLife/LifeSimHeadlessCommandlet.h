@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "LifeSimHeadlessCommandlet.generated.h"
+
+class UWorld;
+
+// Runs the simulation without a viewport, UI or debug drawing, as fast as the
+// CPU allows, and logs how it ended up.
+//
+//   UnrealEditor-Cmd TheMeaningOfLife.uproject -run=LifeSimHeadless -Duration=3600
+//
+// -Map=        Map to load, defaults to /Game/Maps/TestMap
+// -Duration=   Simulated seconds to run, defaults to 600
+// -Scenario=   Ini file with a [Scenario] section. Any of Map, Duration, Seed,
+//              StepsPerTick, GridWidth, GridHeight, InitialPlantCount and
+//              InitialOrganismCount. Command line values win.
+// -Seed=       Seeds FMath::Rand so runs can be repeated
+// -StepsPerTick=  Fixed steps run per world tick, defaults to 16
+// -Benchmark=  Runs the population scaling benchmark instead, e.g.
+//              -Benchmark=100,1000,10000. One step per tick unless -StepsPerTick
+//              says otherwise. Tune it with -DPCVars=lifesim.Benchmark.Seconds=30.
+// -VerifyNoAllocs  Counts heap allocations and fails the run if any frame
+//              after -VerifyWarmup= simulated seconds (default 10) allocates
+//              inside the simulation. Development builds only.
+// -MemReport   Logs lifesim.MemReport for the final population and fails the
+//              run if any entity type is over its lifesim.MemBudget.
+UCLASS()
+class ULifeSimHeadlessCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	ULifeSimHeadlessCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// Loads the map into a game world that is initialized but has not begun play
+	UWorld* CreateGameWorld(const FString& MapName);
+	void DestroyGameWorld(UWorld* World);
+
+	// Environment overrides from the scenario and command line. Applied once actors are
+	// initialized and before BeginPlay, re-registering the environment so the world bounds match.
+	void ApplyOverrides(UWorld* World, const TMap<FString, FString>& Settings);
+
+	// Logs a frame that allocated inside the simulation and counts it
+	void CheckFrameAllocations(const struct FLifeSimFrameStats& Frame, int32& AllocatingFrames);
+};
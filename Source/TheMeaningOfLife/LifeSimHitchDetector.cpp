@@ -0,0 +1,116 @@
+#include "LifeSimHitchDetector.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+
+static TAutoConsoleVariable<float> CVarLifeSimHitchBudget(
+	TEXT("lifesim.Hitch.BudgetMs"),
+	100.0f,
+	TEXT("Frames longer than this dump the recent frame history. 0 turns hitch detection off."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimHitchHistory(
+	TEXT("lifesim.Hitch.HistoryFrames"),
+	300,
+	TEXT("Frames of simulation timings kept for a hitch dump."));
+
+static TAutoConsoleVariable<float> CVarLifeSimHitchCooldown(
+	TEXT("lifesim.Hitch.CooldownSeconds"),
+	10.0f,
+	TEXT("Least time between two hitch dumps."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimHitchTraceSnapshot(
+	TEXT("lifesim.Hitch.TraceSnapshot"),
+	false,
+	TEXT("Also write an Insights trace snapshot with each hitch dump. Needs tracing to be running."));
+
+FLifeSimHitchDetector::FLifeSimHitchDetector()
+	: NextFrame(0)
+	, HistoryLength(0)
+	, NextDumpTime(0.0)
+{
+}
+
+void FLifeSimHitchDetector::AddFrame(const FLifeSimFrameStats& Frame)
+{
+	const float BudgetMs = CVarLifeSimHitchBudget.GetValueOnGameThread();
+	if (BudgetMs <= 0.0f)
+		return;
+
+	// Resized in place, a history change simply starts over
+	const int32 HistoryFrames = FMath::Max(CVarLifeSimHitchHistory.GetValueOnGameThread(), 1);
+	if (HistoryLength != HistoryFrames)
+	{
+		Frames.Empty(HistoryFrames);
+		NextFrame = 0;
+		HistoryLength = HistoryFrames;
+	}
+
+	if (Frames.Num() < HistoryFrames)
+	{
+		Frames.Add(Frame);
+	}
+	else
+	{
+		Frames[NextFrame] = Frame;
+	}
+	NextFrame = (NextFrame + 1) % HistoryFrames;
+
+	if (Frame.FrameMs > BudgetMs && FPlatformTime::Seconds() >= NextDumpTime)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Hitch: frame %llu took %.1f ms (budget %.1f ms), %d steps, %d organisms, %d plants, %d food"),
+			Frame.FrameNumber, Frame.FrameMs, BudgetMs, Frame.NumSteps, Frame.Organisms, Frame.Plants, Frame.Food);
+
+		Dump(TEXT("Hitch"));
+	}
+}
+
+void FLifeSimHitchDetector::GetHistory(TArray<FLifeSimFrameStats>& OutFrames) const
+{
+	OutFrames.Reset(Frames.Num());
+
+	// Until the ring is full the oldest frame is at the front
+	const int32 Oldest = Frames.Num() < HistoryLength ? 0 : NextFrame;
+	for (int32 Offset = 0; Offset < Frames.Num(); Offset++)
+	{
+		OutFrames.Add(Frames[(Oldest + Offset) % Frames.Num()]);
+	}
+}
+
+void FLifeSimHitchDetector::Dump(const TCHAR* Reason)
+{
+	NextDumpTime = FPlatformTime::Seconds() + CVarLifeSimHitchCooldown.GetValueOnGameThread();
+
+	TArray<FLifeSimFrameStats> History;
+	GetHistory(History);
+	if (History.Num() == 0)
+		return;
+
+	const FString BaseName = FPaths::ProfilingDir() / TEXT("LifeSim") /
+		FString::Printf(TEXT("%s-%s-Frame%llu"), Reason, *FDateTime::Now().ToString(), History.Last().FrameNumber);
+
+	FString Csv = TEXT("FrameNumber,FrameMs,NumSteps,OrganismMs,OrganismThreadMs,FoodQueryMs,FoodQueries,PlantMs,ResourceMs,RenderMs,UiMs,Spawns,Destroys,Organisms,Plants,Food\n");
+	for (const FLifeSimFrameStats& Frame : History)
+	{
+		// Left empty for frames that did not count food queries, 0 would read as none made
+		const FString FoodQueryColumns = Frame.bFoodQueriesTracked
+			? FString::Printf(TEXT("%.3f,%d"), Frame.FoodQueryMs, Frame.FoodQueries)
+			: FString(TEXT(","));
+
+		Csv += FString::Printf(TEXT("%llu,%.3f,%d,%.3f,%.3f,%s,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d\n"),
+			Frame.FrameNumber, Frame.FrameMs, Frame.NumSteps, Frame.OrganismMs, Frame.OrganismThreadMs,
+			*FoodQueryColumns, Frame.PlantMs, Frame.ResourceMs, Frame.RenderMs, Frame.UiMs,
+			Frame.Spawns, Frame.Destroys, Frame.Organisms, Frame.Plants, Frame.Food);
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv"))))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Hitch: %d frames written to %s.csv"), History.Num(), *BaseName);
+	}
+
+	if (CVarLifeSimHitchTraceSnapshot.GetValueOnGameThread())
+	{
+		FTraceAuxiliary::WriteSnapshot(*(BaseName + TEXT(".utrace")));
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LifeSimFrameStats.h"
+
+// Keeps the last lifesim.Hitch.HistoryFrames frame stats in a ring. When a
+// frame takes longer than lifesim.Hitch.BudgetMs the ring is written to
+// Saved/Profiling/LifeSim as CSV, oldest frame first and the hitch last, and
+// optionally an Insights trace snapshot next to it.
+// Game thread only, fed by ULifeSimSubsystem at the end of every frame.
+class FLifeSimHitchDetector
+{
+public:
+	FLifeSimHitchDetector();
+
+	void AddFrame(const FLifeSimFrameStats& Frame);
+
+	// Writes the ring now, whether or not anything hitched
+	void Dump(const TCHAR* Reason);
+
+private:
+	// Frames in order, oldest first
+	void GetHistory(TArray<FLifeSimFrameStats>& OutFrames) const;
+
+	TArray<FLifeSimFrameStats> Frames;
+	int32 NextFrame;
+
+	// lifesim.Hitch.HistoryFrames the ring was sized for. Not Frames.Max(), the allocator rounds that up.
+	int32 HistoryLength;
+
+	// No second dump until this wall time, one hitch tends to drag a few more along
+	double NextDumpTime;
+};
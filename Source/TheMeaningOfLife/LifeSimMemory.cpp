@@ -0,0 +1,267 @@
+#include "LifeSimMemory.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/WidgetComponent.h"
+#include "Blueprint/UserWidget.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectHash.h"
+#include "LifeSimSubsystem.h"
+#include "LifeSimRenderer.h"
+#include "OrganismMassSubsystem.h"
+
+LLM_DEFINE_TAG(LifeSim);
+LLM_DEFINE_TAG(LifeSim_Organisms, NAME_None, TEXT("LifeSim"));
+LLM_DEFINE_TAG(LifeSim_Plants, NAME_None, TEXT("LifeSim"));
+LLM_DEFINE_TAG(LifeSim_Food, NAME_None, TEXT("LifeSim"));
+LLM_DEFINE_TAG(LifeSim_Rendering, NAME_None, TEXT("LifeSim"));
+
+static TAutoConsoleVariable<int32> CVarLifeSimMemBudgetOrganism(
+	TEXT("lifesim.MemBudget.OrganismBytes"),
+	64 * 1024,
+	TEXT("Bytes one organism may cost before lifesim.MemReport warns. 0 turns the check off."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimMemBudgetPlant(
+	TEXT("lifesim.MemBudget.PlantBytes"),
+	16 * 1024,
+	TEXT("Bytes one plant may cost before lifesim.MemReport warns. 0 turns the check off."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimMemBudgetFood(
+	TEXT("lifesim.MemBudget.FoodBytes"),
+	8 * 1024,
+	TEXT("Bytes one food item may cost before lifesim.MemReport warns. 0 turns the check off."));
+
+static FAutoConsoleCommandWithWorld LifeSimMemReportCommand(
+	TEXT("lifesim.MemReport"),
+	TEXT("Logs what one organism, plant and food item costs in memory, by component, and warns about types over their lifesim.MemBudget."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		FLifeSimMemoryReport::Report(World);
+	}));
+
+// Measuring serializes every object, a few dozen of each type is plenty for an average
+static constexpr int32 MaxSamplesPerType = 32;
+
+namespace
+{
+	const TCHAR* GetTypeName(ESimEntityType Type)
+	{
+		switch (Type)
+		{
+		case ESimEntityType::Organism: return TEXT("Organism");
+		case ESimEntityType::Plant: return TEXT("Plant");
+		case ESimEntityType::Food: return TEXT("Food");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	// Same numbers as "obj list": properties and their containers, plus owned resources
+	int64 GetObjectBytes(UObject* Object)
+	{
+		FArchiveCountMem Count(Object);
+		return (int64)Count.GetMax() + (int64)Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	// Object and everything nested in it that has not been counted yet
+	int64 CountObjectTree(UObject* Object, TSet<const UObject*>& Counted)
+	{
+		bool bAlreadyCounted = false;
+		Counted.Add(Object, &bAlreadyCounted);
+		int64 Bytes = bAlreadyCounted ? 0 : GetObjectBytes(Object);
+
+		ForEachObjectWithOuter(Object, [&Bytes, &Counted](UObject* Inner)
+		{
+			bool bInnerCounted = false;
+			Counted.Add(Inner, &bInnerCounted);
+			if (!bInnerCounted)
+			{
+				Bytes += GetObjectBytes(Inner);
+			}
+		}, true);
+		return Bytes;
+	}
+
+	void AddPart(TArray<TPair<FString, int64>>& Parts, const FString& Name, int64 Bytes)
+	{
+		for (TPair<FString, int64>& Part : Parts)
+		{
+			if (Part.Key == Name)
+			{
+				Part.Value += Bytes;
+				return;
+			}
+		}
+		Parts.Emplace(Name, Bytes);
+	}
+
+	void MeasureActor(AActor* Actor, TArray<TPair<FString, int64>>& Parts)
+	{
+		TSet<const UObject*> Counted;
+
+		Counted.Add(Actor);
+		AddPart(Parts, TEXT("Actor"), GetObjectBytes(Actor));
+
+		// Picked out first, otherwise they land in the component that created them
+		TInlineComponentArray<UActorComponent*> Components(Actor);
+		for (UActorComponent* Component : Components)
+		{
+			if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+			{
+				for (int32 i = 0; i < Primitive->GetNumMaterials(); i++)
+				{
+					if (UMaterialInstanceDynamic* DynMaterial = Cast<UMaterialInstanceDynamic>(Primitive->GetMaterial(i)))
+					{
+						AddPart(Parts, TEXT("Dynamic material"), CountObjectTree(DynMaterial, Counted));
+					}
+				}
+			}
+
+			// The widget's Slate side is not a UObject and is not included
+			if (UWidgetComponent* WidgetComponent = Cast<UWidgetComponent>(Component))
+			{
+				if (UUserWidget* Widget = WidgetComponent->GetWidget())
+				{
+					AddPart(Parts, FString::Printf(TEXT("Widget (%s)"), *Widget->GetClass()->GetName()), CountObjectTree(Widget, Counted));
+				}
+			}
+		}
+
+		for (UActorComponent* Component : Components)
+		{
+			AddPart(Parts, FString::Printf(TEXT("%s (%s)"), *Component->GetName(), *Component->GetClass()->GetName()), CountObjectTree(Component, Counted));
+		}
+
+		int64 OtherBytes = 0;
+		ForEachObjectWithOuter(Actor, [&OtherBytes, &Counted](UObject* Inner)
+		{
+			bool bAlreadyCounted = false;
+			Counted.Add(Inner, &bAlreadyCounted);
+			if (!bAlreadyCounted)
+			{
+				OtherBytes += GetObjectBytes(Inner);
+			}
+		}, true);
+		if (OtherBytes > 0)
+		{
+			AddPart(Parts, TEXT("Other subobjects"), OtherBytes);
+		}
+	}
+}
+
+int64 FLifeSimEntityFootprint::GetTotalBytes() const
+{
+	int64 Total = 0;
+	for (const TPair<FString, int64>& Part : Parts)
+	{
+		Total += Part.Value;
+	}
+	return Total;
+}
+
+FLifeSimEntityFootprint FLifeSimMemoryReport::Measure(UWorld* World, ESimEntityType Type)
+{
+	FLifeSimEntityFootprint Footprint;
+	Footprint.Type = Type;
+
+	ULifeSimSubsystem* LifeSim = World ? World->GetSubsystem<ULifeSimSubsystem>() : nullptr;
+	if (!LifeSim || Type == ESimEntityType::Count)
+		return Footprint;
+
+	Footprint.Live = LifeSim->GetCount(Type);
+
+	// Evenly spread over the registry, so old and new entities are both in
+	const TArray<AActor*>& Entities = LifeSim->GetEntities(Type);
+	const int32 Stride = FMath::Max(Entities.Num() / MaxSamplesPerType, 1);
+
+	TSet<UClass*> Classes;
+	for (int32 i = 0; i < Entities.Num() && Footprint.Sampled < MaxSamplesPerType; i += Stride)
+	{
+		if (!IsValid(Entities[i]))
+			continue;
+
+		MeasureActor(Entities[i], Footprint.Parts);
+		Classes.Add(Entities[i]->GetClass());
+		Footprint.Sampled++;
+	}
+
+	for (TPair<FString, int64>& Part : Footprint.Parts)
+	{
+		Part.Value /= FMath::Max(Footprint.Sampled, 1);
+	}
+
+	// Parked actors cost as much as live ones
+	for (UClass* Class : Classes)
+	{
+		Footprint.Pooled += LifeSim->GetPooledCount(Class);
+	}
+
+	// Mass organisms are fragments in archetype chunks rather than actors
+	UOrganismMassSubsystem* MassOrganisms = World->GetSubsystem<UOrganismMassSubsystem>();
+	if (Type == ESimEntityType::Organism && Footprint.Sampled == 0 && MassOrganisms && MassOrganisms->GetOrganismCount() > 0)
+	{
+		AddPart(Footprint.Parts, TEXT("Mass fragments"), UOrganismMassSubsystem::GetFragmentBytesPerOrganism());
+		Footprint.Sampled = MassOrganisms->GetOrganismCount();
+	}
+
+	// Share of the instanced mesh drawing this type
+	if (ALifeSimRenderer* Renderer = LifeSim->GetRendererIfSpawned())
+	{
+		const int32 Instances = Renderer->GetInstanceCount(Type);
+		if (Instances > 0)
+		{
+			AddPart(Footprint.Parts, TEXT("Render instance (shared)"), Renderer->GetInstanceAllocatedSize(Type) / Instances);
+		}
+	}
+
+	return Footprint;
+}
+
+bool FLifeSimMemoryReport::Report(UWorld* World)
+{
+	bool bWithinBudget = true;
+
+	UE_LOG(LogTemp, Display, TEXT("===== LifeSim memory per entity ====="));
+
+	for (ESimEntityType Type : { ESimEntityType::Organism, ESimEntityType::Plant, ESimEntityType::Food })
+	{
+		const FLifeSimEntityFootprint Footprint = Measure(World, Type);
+		if (Footprint.Sampled == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: none alive to measure"), GetTypeName(Type));
+			continue;
+		}
+
+		const int64 Bytes = Footprint.GetTotalBytes();
+		const int64 Budget = GetBudgetBytes(Type);
+
+		UE_LOG(LogTemp, Display, TEXT("%s: %.1f KB each, %d live + %d pooled = %.2f MB (budget %.1f KB, %d sampled)"),
+			GetTypeName(Type), Bytes / 1024.0, Footprint.Live, Footprint.Pooled,
+			Bytes * (Footprint.Live + Footprint.Pooled) / (1024.0 * 1024.0), Budget / 1024.0, Footprint.Sampled);
+
+		for (const TPair<FString, int64>& Part : Footprint.Parts)
+		{
+			UE_LOG(LogTemp, Display, TEXT("    %-48s %8.1f KB"), *Part.Key, Part.Value / 1024.0);
+		}
+
+		if (Budget > 0 && Bytes > Budget)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s is over its memory budget: %.1f KB each, budget %.1f KB"),
+				GetTypeName(Type), Bytes / 1024.0, Budget / 1024.0);
+			bWithinBudget = false;
+		}
+	}
+
+	return bWithinBudget;
+}
+
+int64 FLifeSimMemoryReport::GetBudgetBytes(ESimEntityType Type)
+{
+	switch (Type)
+	{
+	case ESimEntityType::Organism: return CVarLifeSimMemBudgetOrganism.GetValueOnGameThread();
+	case ESimEntityType::Plant: return CVarLifeSimMemBudgetPlant.GetValueOnGameThread();
+	case ESimEntityType::Food: return CVarLifeSimMemBudgetFood.GetValueOnGameThread();
+	default: return 0;
+	}
+}
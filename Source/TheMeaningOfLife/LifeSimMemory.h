@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "SimEntityHandle.h"
+
+class UWorld;
+
+// Low-Level Memory Tracker tags, shown under LifeSim in "stat LLMFULL" and in
+// Insights when the game runs with -llm. Scopes go around spawning and
+// BeginPlay, which is where an entity's actor, components, materials and
+// widgets get allocated.
+LLM_DECLARE_TAG(LifeSim);
+LLM_DECLARE_TAG(LifeSim_Organisms);
+LLM_DECLARE_TAG(LifeSim_Plants);
+LLM_DECLARE_TAG(LifeSim_Food);
+LLM_DECLARE_TAG(LifeSim_Rendering);
+
+#define LIFESIM_LLM_SCOPE(Tag) LLM_SCOPE_BYTAG(LifeSim_##Tag)
+
+// What one entity of a type costs, averaged over a sample of live entities
+struct FLifeSimEntityFootprint
+{
+	ESimEntityType Type = ESimEntityType::Count;
+	int32 Live = 0;
+	int32 Sampled = 0;
+	int32 Pooled = 0;
+
+	// Part name (actor, component, material, widget...) -> bytes per entity
+	TArray<TPair<FString, int64>> Parts;
+
+	int64 GetTotalBytes() const;
+};
+
+// Measures entities the way "obj list" does: the object itself, its property
+// containers and the resources it owns exclusively. Native containers the
+// object system cannot see are added by hand. Game thread only.
+// "lifesim.MemReport" logs the result and warns when a type goes over its
+// lifesim.MemBudget.* value.
+class FLifeSimMemoryReport
+{
+public:
+	static FLifeSimEntityFootprint Measure(UWorld* World, ESimEntityType Type);
+
+	// Logs every type, returns false when any of them is over budget
+	static bool Report(UWorld* World);
+
+	// 0 when the type has no budget
+	static int64 GetBudgetBytes(ESimEntityType Type);
+};
@@ -0,0 +1,142 @@
+#include "LifeSimPerfOverlay.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/Border.h"
+#include "Components/TextBlock.h"
+#include "Engine/World.h"
+#include "LifeSimSubsystem.h"
+#include "LifeSimAllocTracker.h"
+
+ULifeSimPerfOverlay::ULifeSimPerfOverlay(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	RefreshInterval = 0.25f;
+	RequestedSpeed = 1.0f;
+	StatsText = nullptr;
+	LifeSim = nullptr;
+	SumFrames = 0;
+	MaxFrameMs = 0.0f;
+	LastFrameNumber = 0;
+	TimeSinceRefresh = 0.0f;
+}
+
+TSharedRef<SWidget> ULifeSimPerfOverlay::RebuildWidget()
+{
+	// A dark box with one block of monospaced text
+	if (WidgetTree && !WidgetTree->RootWidget)
+	{
+		UBorder* Background = WidgetTree->ConstructWidget<UBorder>(UBorder::StaticClass(), TEXT("Background"));
+		Background->SetBrushColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.6f));
+		Background->SetPadding(FMargin(8.0f));
+
+		StatsText = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("StatsText"));
+		FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Mono", 10);
+		StatsText->SetFont(Font);
+		StatsText->SetColorAndOpacity(FSlateColor(FLinearColor::White));
+
+		Background->SetContent(StatsText);
+		WidgetTree->RootWidget = Background;
+	}
+
+	return Super::RebuildWidget();
+}
+
+void ULifeSimPerfOverlay::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	LifeSim = GetWorld() ? GetWorld()->GetSubsystem<ULifeSimSubsystem>() : nullptr;
+
+	// Start a fresh window, whatever was summed before hiding is stale
+	Sum = FLifeSimFrameStats();
+	SumFrames = 0;
+	MaxFrameMs = 0.0f;
+	TimeSinceRefresh = RefreshInterval;
+}
+
+void ULifeSimPerfOverlay::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (!LifeSim)
+		return;
+
+	// Slate ticks after the world, so this is the frame that just finished
+	const FLifeSimFrameStats& Frame = LifeSim->GetLastFrameStats();
+	if (Frame.FrameNumber != LastFrameNumber)
+	{
+		LastFrameNumber = Frame.FrameNumber;
+		Accumulate(Frame);
+	}
+
+	TimeSinceRefresh += InDeltaTime;
+	if (TimeSinceRefresh >= RefreshInterval && SumFrames > 0)
+	{
+		Refresh();
+		TimeSinceRefresh = 0.0f;
+	}
+}
+
+void ULifeSimPerfOverlay::Accumulate(const FLifeSimFrameStats& Frame)
+{
+	Sum.FrameMs += Frame.FrameMs;
+	Sum.NumSteps += Frame.NumSteps;
+	Sum.OrganismMs += Frame.OrganismMs;
+	Sum.OrganismThreadMs += Frame.OrganismThreadMs;
+	Sum.FoodQueryMs += Frame.FoodQueryMs;
+	Sum.FoodQueries += Frame.FoodQueries;
+	Sum.PlantMs += Frame.PlantMs;
+	Sum.ResourceMs += Frame.ResourceMs;
+	Sum.RenderMs += Frame.RenderMs;
+	Sum.UiMs += Frame.UiMs;
+	Sum.DebugDraws += Frame.DebugDraws;
+	for (int32 Index = 0; Index < (int32)ELifeSimAllocScope::Count; Index++)
+	{
+		Sum.HeapAllocs[Index] += Frame.HeapAllocs[Index];
+	}
+	MaxFrameMs = FMath::Max(MaxFrameMs, Frame.FrameMs);
+	SumFrames++;
+}
+
+void ULifeSimPerfOverlay::Refresh()
+{
+	if (!StatsText)
+		return;
+
+	const float Frames = SumFrames;
+	const float FrameMs = Sum.FrameMs / Frames;
+	const float SimulationMs = (Sum.OrganismMs + Sum.PlantMs + Sum.ResourceMs + Sum.RenderMs) / Frames;
+	const float UiMs = Sum.UiMs / Frames;
+
+	// Whatever the frame spent outside the simulation and its UI: engine, rendering, waiting on the GPU
+	const float OtherMs = FMath::Max(FrameMs - SimulationMs - UiMs, 0.0f);
+
+	const FLifeSimFrameStats& Latest = LifeSim->GetLastFrameStats();
+
+	FString Text;
+	Text += FString::Printf(TEXT("Frame      %6.2f ms  (max %.1f, %.0f fps)\n"), FrameMs, MaxFrameMs, FrameMs > 0.0f ? 1000.0f / FrameMs : 0.0f);
+	Text += FString::Printf(TEXT("Steps      %6.2f / frame\n"), Sum.NumSteps / Frames);
+	Text += FString::Printf(TEXT("Organisms  %6.2f ms  (+%.2f sim thread)\n"), Sum.OrganismMs / Frames, Sum.OrganismThreadMs / Frames);
+	Text += FString::Printf(TEXT("Food query %6.2f ms  (%.0f / frame)\n"), Sum.FoodQueryMs / Frames, Sum.FoodQueries / Frames);
+	Text += FString::Printf(TEXT("Plants     %6.2f ms\n"), Sum.PlantMs / Frames);
+	Text += FString::Printf(TEXT("Resources  %6.2f ms\n"), Sum.ResourceMs / Frames);
+	Text += FString::Printf(TEXT("Instances  %6.2f ms\n"), Sum.RenderMs / Frames);
+	Text += FString::Printf(TEXT("UI         %6.2f ms\n"), UiMs);
+	Text += FString::Printf(TEXT("Other      %6.2f ms  (engine, rendering)\n"), OtherMs);
+	Text += FString::Printf(TEXT("Debug draws %5.0f / frame\n"), Sum.DebugDraws / Frames);
+	if (FLifeSimAllocTracker::IsEnabled())
+	{
+		Text += FString::Printf(TEXT("Heap allocs %5.1f / frame  (+%.1f UI)\n"),
+			Sum.GetSimulationHeapAllocs() / Frames, Sum.HeapAllocs[(int32)ELifeSimAllocScope::UI] / Frames);
+	}
+	Text += TEXT("\n");
+	Text += FString::Printf(TEXT("Organisms %d  Plants %d  Food %d\n"), Latest.Organisms, Latest.Plants, Latest.Food);
+	Text += FString::Printf(TEXT("Spawned %.1f/s  Removed %.1f/s\n"), LifeSim->GetSpawnsPerSecond(), LifeSim->GetDestroysPerSecond());
+	Text += FString::Printf(TEXT("Speed %.1fx of %.1fx%s"), LifeSim->GetEffectiveSpeed(), RequestedSpeed,
+		LifeSim->IsFallingBehind() ? TEXT("  FALLING BEHIND") : TEXT(""));
+
+	StatsText->SetText(FText::FromString(Text));
+
+	Sum = FLifeSimFrameStats();
+	SumFrames = 0;
+	MaxFrameMs = 0.0f;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "LifeSimFrameStats.h"
+#include "LifeSimPerfOverlay.generated.h"
+
+class UTextBlock;
+class ULifeSimSubsystem;
+
+// Live simulation cost, toggled with TogglePerfOverlay (F3). Built in code so it
+// needs no widget asset. Frame stats are averaged over each refresh so the
+// numbers stay readable, and the text is only rebuilt a few times a second.
+UCLASS()
+class THEMEANINGOFLIFE_API ULifeSimPerfOverlay : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	ULifeSimPerfOverlay(const FObjectInitializer& ObjectInitializer);
+
+	// Seconds between text updates
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Overlay")
+	float RefreshInterval;
+
+	// Requested speed, the player controller owns it
+	float RequestedSpeed;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+private:
+	void Accumulate(const FLifeSimFrameStats& Frame);
+	void Refresh();
+
+	UPROPERTY()
+	UTextBlock* StatsText;
+
+	UPROPERTY()
+	ULifeSimSubsystem* LifeSim;
+
+	// Frames summed since the last refresh
+	FLifeSimFrameStats Sum;
+	int32 SumFrames;
+	float MaxFrameMs;
+	uint64 LastFrameNumber;
+	float TimeSinceRefresh;
+};
@@ -14,6 +14,29 @@
 #include "PlantActor.h"
 #include "FoodActor.h"
 #include "EnvironmentManager.h"
+#include "LifeSimSubsystem.h"
+#include "OrganismMassSubsystem.h"
+#include "LifeSimStats.h"
+#include "LifeSimAllocTracker.h"
+#include "LifeSimMemory.h"
+#include "LifeSimPerfOverlay.h"
+#include "LifeSimDebugDraw.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarLifeSimSelectionRefreshRate(
+    TEXT("lifesim.UI.SelectionRefreshRate"),
+    4.0f,
+    TEXT("Times per second the selection panel follows the selected entity. 0 refreshes every frame."));
+
+static TAutoConsoleVariable<float> CVarLifeSimResourceBarRate(
+    TEXT("lifesim.UI.ResourceBarRate"),
+    10.0f,
+    TEXT("Most times per second the energy and water bars are refreshed. Counts update as soon as they change."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimResourceBarSteps(
+    TEXT("lifesim.UI.ResourceBarSteps"),
+    200,
+    TEXT("Steps the energy and water bars are quantized to. Changes smaller than a step are not shown."));
 
 ALifeSimPlayerController::ALifeSimPlayerController()
 {
@@ -32,6 +55,8 @@ ALifeSimPlayerController::ALifeSimPlayerController()
     RainWaterCost = 50.0f; // Costs 50 water to make it rain
     RainRadius = 500.0f; // Affects plants within 500 units
     RainWaterAmount = 30.0f; // Gives each plant 30 water
+    RainDuration = 10.0f; // Falls for 10 seconds
+    RainDriftSpeed = 0.0f; // Stays where it was placed
 
     // Load widget classes
     // Selection widget
@@ -90,6 +115,8 @@ ALifeSimPlayerController::ALifeSimPlayerController()
     SelectionInfoWidget = nullptr;
     SelectionNameText = nullptr;
     SelectionInfoScrollBox = nullptr;
+    VisibleInfoRows = 0;
+    NextSelectionRefreshTime = 0.0;
 
     // Simulation speed
     SimulationSpeedWidget = nullptr;
@@ -102,6 +129,10 @@ ALifeSimPlayerController::ALifeSimPlayerController()
     ResourceBarLifeEssenceText = nullptr;
     ResourceBarEnergyBar = nullptr;
     ResourceBarWaterBar = nullptr;
+    NextResourceBarsTime = 0.0;
+
+    // Performance overlay
+    PerfOverlayWidget = nullptr;
 
     // Spawn buttons
     SpawnButtonsWidget = nullptr;
@@ -111,6 +142,8 @@ ALifeSimPlayerController::ALifeSimPlayerController()
     // Rain button
     RainButton = nullptr;
 
+    LifeSim = nullptr;
+
     // Camera defaults
     CameraMoveSpeed = 2000.0f;
     CameraZoomSpeed = 20000.0f;
@@ -132,7 +165,8 @@ ALifeSimPlayerController::ALifeSimPlayerController()
     // Simulation speed defaults
     CurrentSimulationSpeed = 1.0f;
     MinSimulationSpeed = 0.0625f;
-    MaxSimulationSpeed = 16.0f;
+    MaxSimulationSpeed = 128.0f; // Runs as extra fixed steps, results match 1x
+    bSimulationSpeedFallingBehind = false;
 
     // Initialize input
     CameraMoveInput = FVector2D::ZeroVector;
@@ -152,6 +186,8 @@ void ALifeSimPlayerController::BeginPlay()
     bEnableClickEvents = true;
     bEnableMouseOverEvents = true;
 
+    LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+
     // Initialize UI
     CreateSelectionUI();
     CreateSimulationSpeedUI();
@@ -196,21 +232,70 @@ void ALifeSimPlayerController::SetupInputComponent()
 
     // Right click to cancel spawn mode
     InputComponent->BindAction("RightClick", IE_Pressed, this, &ALifeSimPlayerController::ExitSpawnMode);
+
+    // Performance overlay (F3)
+    InputComponent->BindAction("TogglePerfOverlay", IE_Pressed, this, &ALifeSimPlayerController::TogglePerfOverlay);
 }
 
 void ALifeSimPlayerController::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Update Resource UI
-    UpdateResourceBarUI();
+    // UI time and allocations show up in the simulation's frame stats
+    {
+        LIFESIM_ALLOC_SCOPE(UI);
+        const uint64 UiStartCycles = FPlatformTime::Cycles64();
+
+        // Update Resource UI
+        UpdateResourceBarUI();
+
+        // Follow the selected entity live
+        if (!ShownSelection.IsExplicitlyNull() && FPlatformTime::Seconds() >= NextSelectionRefreshTime)
+        {
+            // Parked in a pool counts as gone
+            AActor* Shown = ShownSelection.Get();
+            if (Shown && Shown == CurrentSelectedActor && !Shown->IsHidden())
+            {
+                UpdateSelectionUI(Shown);
+            }
+            else
+            {
+                HideSelectionUI();
+            }
+        }
+
+        // Show how fast the simulation really runs while it cannot keep up
+        if (LifeSim && (LifeSim->IsFallingBehind() || bSimulationSpeedFallingBehind))
+        {
+            bSimulationSpeedFallingBehind = LifeSim->IsFallingBehind();
+            UpdateSimulationSpeedUI();
+        }
+
+        if (LifeSim)
+        {
+            LifeSim->AddUiTime(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - UiStartCycles));
+        }
+    }
+
+#if ENABLE_DRAW_DEBUG
+    // Outline the rain for as long as it is falling
+    if (LifeSim && !ULifeSimSubsystem::IsHeadless())
+    {
+        for (const FLifeSimRainEffect& Rain : LifeSim->GetRainEffects())
+        {
+            DrawDebugCircle(GetWorld(), Rain.Center, Rain.Radius, 48, FColor::Blue, false, -1.0f, 0, 5.0f,
+                FVector(1.0f, 0.0f, 0.0f), FVector(0.0f, 1.0f, 0.0f), false);
+        }
+        LifeSim->AddDebugDraws(LifeSim->GetRainEffects().Num());
+    }
+#endif
 
     APawn* ControlledPawn = GetPawn();
     if (!ControlledPawn)
         return;
 
-    //Get real delta time (unaffected by time dilation)
-    float RealDeltaTime = DeltaTime / CurrentSimulationSpeed;
+    // Speed no longer dilates world time, DeltaTime is already real time
+    float RealDeltaTime = DeltaTime;
 
     // Handle mouse camera control
     if (bIsMouseCameraControlActive)
@@ -320,21 +405,14 @@ void ALifeSimPlayerController::EnterOrganismSpawnMode()
         return;
     }
 
-    // Find environment manager
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnvironmentManager::StaticClass(), FoundActors);
-
-    if (FoundActors.Num() > 0)
+    AEnvironmentManager* EnvManager = GetEnvironment();
+    if (EnvManager && EnvManager->OrganismActorClass)
     {
-        AEnvironmentManager* EnvManager = Cast<AEnvironmentManager>(FoundActors[0]);
-        if (EnvManager && EnvManager->OrganismActorClass)
-        {
-            bIsInSpawnMode = true;
-            CurrentSpawnType = ESpawnType::Organism;
-            PendingSpawnClass = EnvManager->OrganismActorClass;
+        bIsInSpawnMode = true;
+        CurrentSpawnType = ESpawnType::Organism;
+        PendingSpawnClass = EnvManager->OrganismActorClass;
 
-            UE_LOG(LogTemp, Warning, TEXT("Entered Organism spawn mode - click to place"));
-        }
+        UE_LOG(LogTemp, Warning, TEXT("Entered Organism spawn mode - click to place"));
     }
 }
 
@@ -350,21 +428,14 @@ void ALifeSimPlayerController::EnterPlantSpawnMode()
         return;
     }
 
-    // Find environment manager
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnvironmentManager::StaticClass(), FoundActors);
-
-    if (FoundActors.Num() > 0)
+    AEnvironmentManager* EnvManager = GetEnvironment();
+    if (EnvManager && EnvManager->PlantActorClass)
     {
-        AEnvironmentManager* EnvManager = Cast<AEnvironmentManager>(FoundActors[0]);
-        if (EnvManager && EnvManager->PlantActorClass)
-        {
-            bIsInSpawnMode = true;
-            CurrentSpawnType = ESpawnType::Plant;
-            PendingSpawnClass = EnvManager->PlantActorClass;
+        bIsInSpawnMode = true;
+        CurrentSpawnType = ESpawnType::Plant;
+        PendingSpawnClass = EnvManager->PlantActorClass;
 
-            UE_LOG(LogTemp, Warning, TEXT("Entered Plant spawn mode - click to place"));
-        }
+        UE_LOG(LogTemp, Warning, TEXT("Entered Plant spawn mode - click to place"));
     }
 }
 
@@ -400,32 +471,28 @@ void ALifeSimPlayerController::HandleRainClick(const FVector& RainLocation)
         return;
     }
 
+    if (!LifeSim)
+    {
+        ExitRainMode();
+        return;
+    }
+
     // Spend the water
     MyResourceComponent->Water -= RainWaterCost;
 
-    // Find all plants within radius and water them
-    TArray<AActor*> AllPlants;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlantActor::StaticClass(), AllPlants);
-
-    int32 PlantsWatered = 0;
-    for (AActor* Actor : AllPlants)
+    // Rain keeps falling for a while, the simulation waters whatever plants end up under it
+    FLifeSimRainEffect Rain;
+    Rain.Center = RainLocation;
+    Rain.Radius = RainRadius;
+    Rain.TimeRemaining = FMath::Max(RainDuration, 0.1f);
+    Rain.WaterPerSecond = RainWaterAmount / Rain.TimeRemaining;
+    if (RainDriftSpeed > 0.0f)
     {
-        float Distance = FVector::Dist(RainLocation, Actor->GetActorLocation());
-        if (Distance <= RainRadius)
-        {
-            APlantActor* Plant = Cast<APlantActor>(Actor);
-            if (Plant)
-            {
-                Plant->AddWater(RainWaterAmount);
-                PlantsWatered++;
-            }
-        }
+        Rain.Velocity = FMath::VRand().GetSafeNormal2D() * RainDriftSpeed;
     }
+    LifeSim->AddRain(Rain);
 
-    // Draw debug sphere to show rain area
-    DrawDebugSphere(GetWorld(), RainLocation, RainRadius, 32, FColor::Blue, false, 2.0f, 0, 5.0f);
-
-    UE_LOG(LogTemp, Warning, TEXT("Made it rain! Watered %d plants"), PlantsWatered);
+    UE_LOG(LogTemp, Warning, TEXT("Made it rain! %.0f seconds over %.0f units"), Rain.TimeRemaining, Rain.Radius);
 
     // Exit rain mode after use
     ExitRainMode();
@@ -473,13 +540,23 @@ void ALifeSimPlayerController::HandleSpawnClick(const FVector& MySpawnLocation)
             return;
         }
 
-        // Spawn organism
-        AOrganismActor* NewOrganism = GetWorld()->SpawnActor<AOrganismActor>(
-            PendingSpawnClass,
-            MySpawnLocation,
-            FRotator::ZeroRotator,
-            SpawnParams
-        );
+        // Spawn as a Mass entity when that backend is on
+        UOrganismMassSubsystem* MassOrganisms = GetWorld()->GetSubsystem<UOrganismMassSubsystem>();
+        if (MassOrganisms && UOrganismMassSubsystem::IsEnabled())
+        {
+            if (MassOrganisms->SpawnOrganism(MySpawnLocation, PendingSpawnClass.Get()).IsSet())
+            {
+                MyResourceComponent->SpendResources(50.0f, 0.0f, 1);
+            }
+            return;
+        }
+
+        // Spawn organism, reusing a parked one when the pool has any
+        LIFESIM_LLM_SCOPE(Organisms);
+        ULifeSimSubsystem* LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+        AOrganismActor* NewOrganism = LifeSim
+            ? Cast<AOrganismActor>(LifeSim->AcquireActor(PendingSpawnClass, MySpawnLocation))
+            : GetWorld()->SpawnActor<AOrganismActor>(PendingSpawnClass, MySpawnLocation, FRotator::ZeroRotator, SpawnParams);
 
         if (NewOrganism)
         {
@@ -500,6 +577,7 @@ void ALifeSimPlayerController::HandleSpawnClick(const FVector& MySpawnLocation)
         }
 
         // Spawn plant
+        LIFESIM_LLM_SCOPE(Plants);
         APlantActor* NewPlant = GetWorld()->SpawnActor<APlantActor>(
             PendingSpawnClass,
             MySpawnLocation,
@@ -510,15 +588,10 @@ void ALifeSimPlayerController::HandleSpawnClick(const FVector& MySpawnLocation)
         if (NewPlant)
         {
             // Give plant reference to food class
-            TArray<AActor*> FoundActors;
-            UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnvironmentManager::StaticClass(), FoundActors);
-            if (FoundActors.Num() > 0)
+            AEnvironmentManager* EnvManager = GetEnvironment();
+            if (EnvManager && EnvManager->FoodActorClass)
             {
-                AEnvironmentManager* EnvManager = Cast<AEnvironmentManager>(FoundActors[0]);
-                if (EnvManager && EnvManager->FoodActorClass)
-                {
-                    NewPlant->FoodActorClass = EnvManager->FoodActorClass;
-                }
+                NewPlant->FoodActorClass = EnvManager->FoodActorClass;
             }
 
             Resources->SpendResources(0.0f, 50.0f, 1);
@@ -528,6 +601,11 @@ void ALifeSimPlayerController::HandleSpawnClick(const FVector& MySpawnLocation)
     }
 }
 
+AEnvironmentManager* ALifeSimPlayerController::GetEnvironment() const
+{
+    return LifeSim ? LifeSim->GetContext().Environment : nullptr;
+}
+
 FVector ALifeSimPlayerController::GetMouseWorldPosition()
 {
     FHitResult HitResult;
@@ -663,9 +741,15 @@ void ALifeSimPlayerController::ResetSimulationSpeed()
 
 void ALifeSimPlayerController::UpdateSimulationSpeed()
 {
-    if (UWorld* World = GetWorld())
+    // The subsystem runs more fixed steps per frame instead of stretching DeltaTime
+    if (LifeSim)
     {
-        UGameplayStatics::SetGlobalTimeDilation(World, CurrentSimulationSpeed);
+        LifeSim->SetSimulationSpeed(CurrentSimulationSpeed);
+    }
+
+    if (PerfOverlayWidget)
+    {
+        PerfOverlayWidget->RequestedSpeed = CurrentSimulationSpeed;
     }
 
     UpdateSimulationSpeedUI();
@@ -707,6 +791,16 @@ void ALifeSimPlayerController::HandleLeftClick()
         SelectableActor = Cast<ISelectable>(HitActor);
     }
 
+    // Mass organisms have no actor to hit until one is materialized for them
+    if (!SelectableActor && bHit && UOrganismMassSubsystem::IsEnabled())
+    {
+        if (UOrganismMassSubsystem* MassOrganisms = GetWorld()->GetSubsystem<UOrganismMassSubsystem>())
+        {
+            HitActor = MassOrganisms->MaterializeNearest(HitResult.Location, 75.0f);
+            SelectableActor = Cast<ISelectable>(HitActor);
+        }
+    }
+
     if (SelectableActor)
     {
         // Deselect previous if different
@@ -823,6 +917,8 @@ void ALifeSimPlayerController::CreateSelectionUI()
 
 void ALifeSimPlayerController::UpdateSelectionUI(AActor* SelectedActor)
 {
+    LIFESIM_SCOPE(STAT_LifeSim_SelectionUI);
+
     if (!SelectionInfoWidget || !SelectedActor)
         return;
 
@@ -830,51 +926,83 @@ void ALifeSimPlayerController::UpdateSelectionUI(AActor* SelectedActor)
     if (!Selectable)
         return;
 
-    // Show the widget
-    SelectionInfoWidget->SetVisibility(ESlateVisibility::Visible);
+    const float Rate = CVarLifeSimSelectionRefreshRate.GetValueOnGameThread();
+    NextSelectionRefreshTime = Rate > 0.0f ? FPlatformTime::Seconds() + 1.0 / Rate : 0.0;
 
-    // Update name
-    if (SelectionNameText)
+    // A new selection starts from an empty panel
+    if (SelectedActor != ShownSelection.Get())
     {
-        SelectionNameText->SetText(FText::FromString(Selectable->GetDisplayName()));
+        ShownSelection = SelectedActor;
+        ShownProperties.Reset();
+
+        // Show the widget
+        SelectionInfoWidget->SetVisibility(ESlateVisibility::Visible);
+
+        // Update name
+        if (SelectionNameText)
+        {
+            SelectionNameText->SetText(FText::FromString(Selectable->GetDisplayName()));
+        }
     }
 
-    // Clear and rebuild info list
-    if (SelectionInfoScrollBox)
+    if (!SelectionInfoScrollBox || !InfoRowWidgetClass)
+        return;
+
+    // Get info from the selected actor
+    PendingProperties.Reset();
+    Selectable->GetDisplayProperties(PendingProperties);
+
+    // Grow the row pool on demand, rows are never destroyed
+    while (InfoRows.Num() < PendingProperties.Num())
     {
-        SelectionInfoScrollBox->ClearChildren();
+        UUserWidget* RowWidget = CreateWidget<UUserWidget>(this, InfoRowWidgetClass);
+        if (!RowWidget)
+            break;
+
+        InfoRows.Add(RowWidget);
+        InfoRowNameTexts.Add(Cast<UTextBlock>(RowWidget->GetWidgetFromName(TEXT("PropertyNameText"))));
+        InfoRowValueTexts.Add(Cast<UTextBlock>(RowWidget->GetWidgetFromName(TEXT("PropertyValueText"))));
+        SelectionInfoScrollBox->AddChild(RowWidget);
+        VisibleInfoRows++;
+    }
 
-        // Get info from the selected actor
-        TArray<TPair<FString, FString>> Info = Selectable->GetDisplayInfo();
+    const int32 NumRows = FMath::Min(PendingProperties.Num(), InfoRows.Num());
+    SetVisibleInfoRows(NumRows);
+
+    // Set the text values, only for rows that read differently now
+    for (int32 i = 0; i < NumRows; i++)
+    {
+        const FSelectableProperty& Property = PendingProperties[i];
+        const FSelectableProperty* Shown = ShownProperties.IsValidIndex(i) ? &ShownProperties[i] : nullptr;
+        if (Shown && Property.DisplaysSameAs(*Shown))
+            continue;
 
-        // Use the InfoRowWidgetClass we loaded in constructor
-        if (InfoRowWidgetClass)
+        if (InfoRowNameTexts[i] && (!Shown || FCString::Strcmp(Property.Name, Shown->Name) != 0))
         {
-            for (const TPair<FString, FString>& InfoPair : Info)
-            {
-                UUserWidget* RowWidget = CreateWidget<UUserWidget>(this, InfoRowWidgetClass);
-
-                if (RowWidget)
-                {
-                    // Set the text values
-                    UTextBlock* PropNameText = Cast<UTextBlock>(RowWidget->GetWidgetFromName(TEXT("PropertyNameText")));
-                    UTextBlock* PropValueText = Cast<UTextBlock>(RowWidget->GetWidgetFromName(TEXT("PropertyValueText")));
-
-                    if (PropNameText)
-                    {
-                        PropNameText->SetText(FText::FromString(InfoPair.Key + TEXT(":")));
-                    }
-
-                    if (PropValueText)
-                    {
-                        PropValueText->SetText(FText::FromString(InfoPair.Value));
-                    }
-
-                    SelectionInfoScrollBox->AddChild(RowWidget);
-                }
-            }
+            InfoRowNameTexts[i]->SetText(FText::FromString(FString(Property.Name) + TEXT(":")));
+        }
+
+        if (InfoRowValueTexts[i])
+        {
+            InfoRowValueTexts[i]->SetText(FText::FromString(Property.FormatValue()));
         }
     }
+
+    // Both arrays keep their memory for the next refresh
+    Swap(ShownProperties, PendingProperties);
+}
+
+void ALifeSimPlayerController::SetVisibleInfoRows(int32 Count)
+{
+    for (int32 i = Count; i < VisibleInfoRows; i++)
+    {
+        InfoRows[i]->SetVisibility(ESlateVisibility::Collapsed);
+    }
+    for (int32 i = VisibleInfoRows; i < Count; i++)
+    {
+        InfoRows[i]->SetVisibility(ESlateVisibility::Visible);
+    }
+    VisibleInfoRows = Count;
 }
 
 void ALifeSimPlayerController::HideSelectionUI()
@@ -883,6 +1011,10 @@ void ALifeSimPlayerController::HideSelectionUI()
     {
         SelectionInfoWidget->SetVisibility(ESlateVisibility::Hidden);
     }
+
+    // Stop following it, the next selection fills every row again
+    ShownSelection.Reset();
+    ShownProperties.Reset();
 }
 
 void ALifeSimPlayerController::CreateSimulationSpeedUI()
@@ -912,6 +1044,8 @@ void ALifeSimPlayerController::CreateSimulationSpeedUI()
 
 void ALifeSimPlayerController::UpdateSimulationSpeedUI()
 {
+    LIFESIM_SCOPE(STAT_LifeSim_SpeedUI);
+
     if (!SimulationSpeedWidget) 
         return;
 
@@ -921,7 +1055,12 @@ void ALifeSimPlayerController::UpdateSimulationSpeedUI()
     // Update text
     if (SimulationSpeedText)
     {
-        SimulationSpeedText->SetText(FText::FromString("Simulation Speed: " + FString::SanitizeFloat(CurrentSimulationSpeed) + "x"));
+        FString SpeedText = "Simulation Speed: " + FString::SanitizeFloat(CurrentSimulationSpeed) + "x";
+        if (LifeSim && LifeSim->IsFallingBehind())
+        {
+            SpeedText += FString::Printf(TEXT(" (falling behind, %.1fx)"), LifeSim->GetEffectiveSpeed());
+        }
+        SimulationSpeedText->SetText(FText::FromString(SpeedText));
     }
 }
 
@@ -964,35 +1103,72 @@ void ALifeSimPlayerController::CreateResourceBarUI()
 
 void ALifeSimPlayerController::UpdateResourceBarUI()
 {
-    if (!ResourceBarWidget)
+    LIFESIM_SCOPE(STAT_LifeSim_ResourceUI);
+
+    if (!ResourceBarWidget || !LifeSim)
         return;
 
-    // Show the widget
-    ResourceBarWidget->SetVisibility(ESlateVisibility::Visible);
+    // Show the widget, once until it is hidden again
+    if (ShownResources.OrganismCount == INDEX_NONE)
+    {
+        ResourceBarWidget->SetVisibility(ESlateVisibility::Visible);
+    }
 
-    // Update text
-    if (ResourceBarOrganismText)
+    // Read the published snapshot so a running simulation step never holds up the UI
+    const FLifeSimSnapshot& Snapshot = LifeSim->GetLatestSnapshot();
+
+    // Update text, only what changed so the layout is not invalidated every frame
+    if (Snapshot.OrganismCount != ShownResources.OrganismCount || Snapshot.OrganismCap != ShownResources.OrganismCap)
     {
-        ResourceBarOrganismText->SetText(FText::FromString(MyResourceComponent->OrganismInfoToString()));
+        ShownResources.OrganismCount = Snapshot.OrganismCount;
+        ShownResources.OrganismCap = Snapshot.OrganismCap;
+        if (ResourceBarOrganismText)
+        {
+            ResourceBarOrganismText->SetText(FText::FromString(FString::Printf(TEXT("Organisms: %d/%d"), Snapshot.OrganismCount, Snapshot.OrganismCap)));
+        }
     }
-    if (ResourceBarPlantText)
+    if (Snapshot.PlantCount != ShownResources.PlantCount || Snapshot.PlantCap != ShownResources.PlantCap)
     {
-        ResourceBarPlantText->SetText(FText::FromString(MyResourceComponent->PlantInfoToString()));
+        ShownResources.PlantCount = Snapshot.PlantCount;
+        ShownResources.PlantCap = Snapshot.PlantCap;
+        if (ResourceBarPlantText)
+        {
+            ResourceBarPlantText->SetText(FText::FromString(FString::Printf(TEXT("Plants: %d/%d"), Snapshot.PlantCount, Snapshot.PlantCap)));
+        }
     }
-    if (ResourceBarLifeEssenceText)
+    if (Snapshot.LifeEssence != ShownResources.LifeEssence || Snapshot.MaxLifeEssence != ShownResources.MaxLifeEssence)
     {
-        ResourceBarLifeEssenceText->SetText(FText::FromString(MyResourceComponent->LifeEssenceInfoToString()));
+        ShownResources.LifeEssence = Snapshot.LifeEssence;
+        ShownResources.MaxLifeEssence = Snapshot.MaxLifeEssence;
+        if (ResourceBarLifeEssenceText)
+        {
+            ResourceBarLifeEssenceText->SetText(FText::FromString(FString::Printf(TEXT("Life Essence: %d/%d"), Snapshot.LifeEssence, Snapshot.MaxLifeEssence)));
+        }
     }
 
+    // Energy and water drift every step, they refresh at a capped rate
+    const double Now = FPlatformTime::Seconds();
+    if (Now < NextResourceBarsTime)
+        return;
+
+    const float Rate = CVarLifeSimResourceBarRate.GetValueOnGameThread();
+    NextResourceBarsTime = Rate > 0.0f ? Now + 1.0 / Rate : 0.0;
+
     // Update progress bars
-    if (ResourceBarEnergyBar)
+    const int32 Steps = FMath::Max(CVarLifeSimResourceBarSteps.GetValueOnGameThread(), 1);
+    const int32 EnergyStep = FMath::RoundToInt(FMath::Clamp(Snapshot.GetEnergyPercent(), 0.0f, 1.0f) * Steps);
+    const int32 WaterStep = FMath::RoundToInt(FMath::Clamp(Snapshot.GetWaterPercent(), 0.0f, 1.0f) * Steps);
+
+    if (ResourceBarEnergyBar && EnergyStep != ShownResources.EnergyStep)
     {
-        ResourceBarEnergyBar->SetPercent(MyResourceComponent->GetEnergyPercent());
+        ResourceBarEnergyBar->SetPercent((float)EnergyStep / Steps);
     }
-    if (ResourceBarWaterBar)
+    if (ResourceBarWaterBar && WaterStep != ShownResources.WaterStep)
     {
-        ResourceBarWaterBar->SetPercent(MyResourceComponent->GetWaterPercent());
+        ResourceBarWaterBar->SetPercent((float)WaterStep / Steps);
     }
+    ShownResources.EnergyStep = EnergyStep;
+    ShownResources.WaterStep = WaterStep;
 }
 
 void ALifeSimPlayerController::HideResourceBarUI()
@@ -1001,4 +1177,42 @@ void ALifeSimPlayerController::HideResourceBarUI()
     {
         ResourceBarWidget->SetVisibility(ESlateVisibility::Hidden);
     }
-}
\ No newline at end of file
+
+    // Everything is set again when it is next shown
+    ShownResources = FResourceBarView();
+    NextResourceBarsTime = 0.0;
+}
+
+void ALifeSimPlayerController::TogglePerfOverlay()
+{
+    if (!PerfOverlayWidget)
+    {
+        PerfOverlayWidget = CreateWidget<ULifeSimPerfOverlay>(this, ULifeSimPerfOverlay::StaticClass());
+        if (!PerfOverlayWidget)
+            return;
+
+        PerfOverlayWidget->RequestedSpeed = CurrentSimulationSpeed;
+
+        // Top right, clear of the resource bar and speed text. Clicks go through to the world.
+        PerfOverlayWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+        PerfOverlayWidget->AddToViewport(10);
+        PerfOverlayWidget->SetAnchorsInViewport(FAnchors(1.0f, 0.0f));
+        PerfOverlayWidget->SetAlignmentInViewport(FVector2D(1.0f, 0.0f));
+        PerfOverlayWidget->SetPositionInViewport(FVector2D(-10.0f, 10.0f), false);
+
+        if (LifeSim)
+        {
+            LifeSim->SetPerfOverlayVisible(true);
+        }
+        return;
+    }
+
+    // Collapsed widgets do not tick, so a hidden overlay costs nothing
+    const bool bVisible = PerfOverlayWidget->GetVisibility() != ESlateVisibility::Collapsed;
+    PerfOverlayWidget->SetVisibility(bVisible ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+
+    if (LifeSim)
+    {
+        LifeSim->SetPerfOverlayVisible(!bVisible);
+    }
+}
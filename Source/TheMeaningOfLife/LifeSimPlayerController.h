@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "ResourceComponent.h"
+#include "Selectable.h"
 #include "LifeSimPlayerController.generated.h"
 
 UCLASS()
@@ -76,12 +77,19 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation")
     float MaxSimulationSpeed;
 
+    // Speed text shows the effective speed while this is set
+    bool bSimulationSpeedFallingBehind;
+
     UPROPERTY()
     TSubclassOf<UUserWidget> SelectionInfoWidgetClass;
 
     UPROPERTY()
     TSubclassOf<UUserWidget> InfoRowWidgetClass;
 
+    // Info rows stay in the scroll box and are reused, spare ones are collapsed
+    UPROPERTY()
+    TArray<UUserWidget*> InfoRows;
+
     UPROPERTY()
     TSubclassOf<UUserWidget> SimulationSpeedWidgetClass;
 
@@ -97,6 +105,10 @@ public:
     UPROPERTY()
     class UUserWidget* ResourceBarWidget;
 
+    // Performance overlay, created the first time it is shown
+    UPROPERTY()
+    class ULifeSimPerfOverlay* PerfOverlayWidget;
+
     // Spawn UI
     UPROPERTY()
     TSubclassOf<UUserWidget> SpawnButtonsWidgetClass;
@@ -143,7 +155,13 @@ public:
     float RainRadius; // How far the rain reaches
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rain")
-    float RainWaterAmount; // How much water each plant gets
+    float RainWaterAmount; // How much water each plant gets over the whole rain
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rain")
+    float RainDuration; // How long the rain keeps falling (seconds)
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rain")
+    float RainDriftSpeed; // How fast the rain drifts off in a random direction, 0 stays put
 
 private:
     void HandleRainClick(const FVector& RainLocation);
@@ -152,6 +170,10 @@ private:
     void CreateSpawnUI();
     void SetupSpawnButtonCallbacks();
     FVector GetMouseWorldPosition();
+    class AEnvironmentManager* GetEnvironment() const;
+
+    UPROPERTY()
+    class ULifeSimSubsystem* LifeSim;
 
     class UButton* SpawnOrganismButton;
     class UButton* SpawnPlantButton;
@@ -201,9 +223,39 @@ private:
     class UProgressBar* ResourceBarEnergyBar;
     class UProgressBar* ResourceBarWaterBar;
 
+    // Parallel to InfoRows
+    TArray<class UTextBlock*> InfoRowNameTexts;
+    TArray<class UTextBlock*> InfoRowValueTexts;
+    int32 VisibleInfoRows;
+
+    // What the selection panel shows and for whom. Refreshed live at
+    // lifesim.UI.SelectionRefreshRate, only rows whose text changed are set.
+    TWeakObjectPtr<AActor> ShownSelection;
+    TArray<FSelectableProperty> ShownProperties;
+    TArray<FSelectableProperty> PendingProperties;
+    double NextSelectionRefreshTime;
+
+    // What the resource bar currently shows. Texts are only set when their
+    // numbers change, bars at most lifesim.UI.ResourceBarRate times a second
+    // and only when they move by a whole lifesim.UI.ResourceBarSteps step.
+    struct FResourceBarView
+    {
+        int32 OrganismCount = INDEX_NONE;
+        int32 OrganismCap = INDEX_NONE;
+        int32 PlantCount = INDEX_NONE;
+        int32 PlantCap = INDEX_NONE;
+        int32 LifeEssence = INDEX_NONE;
+        int32 MaxLifeEssence = INDEX_NONE;
+        int32 EnergyStep = INDEX_NONE;
+        int32 WaterStep = INDEX_NONE;
+    };
+    FResourceBarView ShownResources;
+    double NextResourceBarsTime;
+
     // Helper functions
     void CreateSelectionUI();
     void UpdateSelectionUI(AActor* SelectedActor);
+    void SetVisibleInfoRows(int32 Count);
     void HideSelectionUI();
     void CreateSimulationSpeedUI();
     void UpdateSimulationSpeedUI();
@@ -211,4 +263,5 @@ private:
     void CreateResourceBarUI();
     void UpdateResourceBarUI();
     void HideResourceBarUI();
+    void TogglePerfOverlay();
 };
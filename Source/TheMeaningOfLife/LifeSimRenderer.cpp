@@ -0,0 +1,263 @@
+#include "LifeSimRenderer.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/Material.h"
+#include "LifeSimMemory.h"
+
+namespace
+{
+	UHierarchicalInstancedStaticMeshComponent* CreateInstances(AActor* Owner, USceneComponent* Root, FName Name, UStaticMesh* Mesh)
+	{
+		UHierarchicalInstancedStaticMeshComponent* Instances = Owner->CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(Name);
+		Instances->SetupAttachment(Root);
+		Instances->SetStaticMesh(Mesh);
+		Instances->NumCustomDataFloats = 3;
+
+		// Actors keep their own (hidden) collision for selection
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Instances->SetMobility(EComponentMobility::Movable);
+		return Instances;
+	}
+}
+
+ALifeSimRenderer::ALifeSimRenderer()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent = Root;
+
+	// Same meshes the actors use
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Engine/BasicShapes/Cube"));
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(TEXT("/Engine/BasicShapes/Cylinder"));
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> SphereMesh(TEXT("/Engine/BasicShapes/Sphere"));
+
+	OrganismInstances = CreateInstances(this, Root, TEXT("OrganismInstances"), CubeMesh.Object);
+	PlantInstances = CreateInstances(this, Root, TEXT("PlantInstances"), CylinderMesh.Object);
+	FoodInstances = CreateInstances(this, Root, TEXT("FoodInstances"), SphereMesh.Object);
+
+	// Set here rather than in BeginPlay, entities can spawn before the world begins play
+	InstanceSets[(int32)ESimEntityType::Organism].Component = OrganismInstances;
+	InstanceSets[(int32)ESimEntityType::Plant].Component = PlantInstances;
+	InstanceSets[(int32)ESimEntityType::Food].Component = FoodInstances;
+
+	InstanceMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Materials/M_LifeSimInstance.M_LifeSimInstance")));
+}
+
+void ALifeSimRenderer::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UMaterialInterface* Material = InstanceMaterial.LoadSynchronous();
+	if (Material)
+	{
+		OrganismInstances->SetMaterial(0, Material);
+		PlantInstances->SetMaterial(0, Material);
+		FoodInstances->SetMaterial(0, Material);
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("LifeSimRenderer: instance material not found, drawing each type in its base color"));
+
+	// One dynamic material per type, not per entity
+	UMaterial* BaseMaterial = LoadObject<UMaterial>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial"));
+	if (!BaseMaterial)
+		return;
+
+	const TPair<UHierarchicalInstancedStaticMeshComponent*, FLinearColor> BaseColors[] = {
+		{ OrganismInstances, FLinearColor(0.4f, 0.3f, 0.8f, 1.0f) },
+		{ PlantInstances, FLinearColor(0.2f, 0.7f, 0.2f, 1.0f) },
+		{ FoodInstances, FLinearColor(0.69f, 0.15f, 0.55f, 1.0f) }
+	};
+
+	for (const TPair<UHierarchicalInstancedStaticMeshComponent*, FLinearColor>& BaseColor : BaseColors)
+	{
+		UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+		DynMaterial->SetVectorParameterValue(FName("Color"), BaseColor.Value);
+		BaseColor.Key->SetMaterial(0, DynMaterial);
+	}
+}
+
+ALifeSimRenderer::FInstanceSet* ALifeSimRenderer::GetInstanceSet(ESimEntityType Type)
+{
+	if (Type == ESimEntityType::Count || !InstanceSets[(int32)Type].Component)
+		return nullptr;
+
+	return &InstanceSets[(int32)Type];
+}
+
+int32 ALifeSimRenderer::GetInstanceCount(ESimEntityType Type) const
+{
+	return Type != ESimEntityType::Count ? InstanceSets[(int32)Type].Transforms.Num() : 0;
+}
+
+SIZE_T ALifeSimRenderer::GetInstanceAllocatedSize(ESimEntityType Type) const
+{
+	if (Type == ESimEntityType::Count)
+		return 0;
+
+	const FInstanceSet& Set = InstanceSets[(int32)Type];
+	SIZE_T Bytes = Set.Transforms.GetAllocatedSize()
+		+ Set.PreviousTransforms.GetAllocatedSize()
+		+ Set.DrawTransforms.GetAllocatedSize()
+		+ Set.IndexToId.GetAllocatedSize()
+		+ Set.IdToIndex.GetAllocatedSize()
+		+ Set.FreeIds.GetAllocatedSize();
+
+	if (Set.Component)
+	{
+		Bytes += Set.Component->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+	return Bytes;
+}
+
+void ALifeSimRenderer::SetCustomColor(FInstanceSet& Set, int32 Index, const FLinearColor& Color)
+{
+	const float CustomData[NumCustomDataFloats] = { Color.R, Color.G, Color.B };
+	Set.Component->SetCustomData(Index, MakeArrayView(CustomData), false);
+	Set.bRenderStateDirty = true;
+}
+
+int32 ALifeSimRenderer::AddInstance(ESimEntityType Type, const FTransform& Transform, const FLinearColor& Color)
+{
+	LIFESIM_LLM_SCOPE(Rendering);
+
+	FInstanceSet* Set = GetInstanceSet(Type);
+	if (!Set)
+		return INDEX_NONE;
+
+	int32 InstanceId;
+	if (Set->FreeIds.Num() > 0)
+	{
+		InstanceId = Set->FreeIds.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		InstanceId = Set->IdToIndex.Add(INDEX_NONE);
+	}
+
+	const int32 Index = Set->Transforms.Add(Transform);
+	Set->PreviousTransforms.Add(Transform);
+	Set->IndexToId.Add(InstanceId);
+	Set->IdToIndex[InstanceId] = Index;
+
+	// Appending never moves existing instances
+	Set->Component->AddInstance(Transform, false);
+	SetCustomColor(*Set, Index, Color);
+
+	return InstanceId;
+}
+
+void ALifeSimRenderer::RemoveInstance(ESimEntityType Type, int32 InstanceId)
+{
+	FInstanceSet* Set = GetInstanceSet(Type);
+	if (!Set || !Set->IdToIndex.IsValidIndex(InstanceId) || Set->IdToIndex[InstanceId] == INDEX_NONE)
+		return;
+
+	const int32 Index = Set->IdToIndex[InstanceId];
+	const int32 LastIndex = Set->Transforms.Num() - 1;
+
+	// Move the last instance into the hole, then drop the last slot. Removing
+	// from the end keeps every other instance index where it is.
+	if (Index != LastIndex)
+	{
+		const int32 MovedId = Set->IndexToId[LastIndex];
+		Set->Transforms[Index] = Set->Transforms[LastIndex];
+		Set->PreviousTransforms[Index] = Set->PreviousTransforms[LastIndex];
+		Set->IndexToId[Index] = MovedId;
+		Set->IdToIndex[MovedId] = Index;
+
+		TArray<float, TInlineAllocator<NumCustomDataFloats>> MovedCustomData;
+		MovedCustomData.Append(&Set->Component->PerInstanceSMCustomData[LastIndex * NumCustomDataFloats], NumCustomDataFloats);
+		Set->Component->SetCustomData(Index, MovedCustomData, false);
+
+		Set->bTransformsDirty = true;
+	}
+
+	Set->Transforms.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+	Set->PreviousTransforms.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+	Set->IndexToId.RemoveAt(LastIndex, 1, EAllowShrinking::No);
+	Set->IdToIndex[InstanceId] = INDEX_NONE;
+	Set->FreeIds.Add(InstanceId);
+
+	Set->Component->RemoveInstance(LastIndex);
+	Set->bRenderStateDirty = true;
+}
+
+void ALifeSimRenderer::SetInstanceTransform(ESimEntityType Type, int32 InstanceId, const FTransform& Transform)
+{
+	FInstanceSet* Set = GetInstanceSet(Type);
+	if (!Set || !Set->IdToIndex.IsValidIndex(InstanceId) || Set->IdToIndex[InstanceId] == INDEX_NONE)
+		return;
+
+	Set->Transforms[Set->IdToIndex[InstanceId]] = Transform;
+	Set->bTransformsDirty = true;
+	Set->bInterpolating = true;
+}
+
+void ALifeSimRenderer::SetInstanceColor(ESimEntityType Type, int32 InstanceId, const FLinearColor& Color)
+{
+	FInstanceSet* Set = GetInstanceSet(Type);
+	if (!Set || !Set->IdToIndex.IsValidIndex(InstanceId) || Set->IdToIndex[InstanceId] == INDEX_NONE)
+		return;
+
+	SetCustomColor(*Set, Set->IdToIndex[InstanceId], Color);
+}
+
+void ALifeSimRenderer::BeginInterpolation()
+{
+	for (FInstanceSet& Set : InstanceSets)
+	{
+		// Only sets that moved since the last time need a new starting point
+		if (Set.bInterpolating)
+		{
+			Set.PreviousTransforms = Set.Transforms;
+			Set.bInterpolating = false;
+		}
+	}
+}
+
+void ALifeSimRenderer::Flush(float Alpha)
+{
+	Alpha = FMath::Clamp(Alpha, 0.0f, 1.0f);
+
+	for (FInstanceSet& Set : InstanceSets)
+	{
+		if (!Set.Component)
+			continue;
+
+		// One batch per type, however many instances moved
+		if (Set.bInterpolating && Alpha < 1.0f && Set.Transforms.Num() > 0)
+		{
+			// Only location changes, rotation and scale are the same for every instance
+			Set.DrawTransforms = Set.Transforms;
+			for (int32 Index = 0; Index < Set.DrawTransforms.Num(); Index++)
+			{
+				Set.DrawTransforms[Index].SetLocation(FMath::Lerp(
+					Set.PreviousTransforms[Index].GetLocation(), Set.Transforms[Index].GetLocation(), Alpha));
+			}
+
+			Set.Component->BatchUpdateInstancesTransforms(0, Set.DrawTransforms, false, false, true);
+			Set.bRenderStateDirty = true;
+		}
+		else if ((Set.bTransformsDirty || Set.bInterpolating) && Set.Transforms.Num() > 0)
+		{
+			Set.Component->BatchUpdateInstancesTransforms(0, Set.Transforms, false, false, true);
+			Set.bRenderStateDirty = true;
+
+			// Arrived, nothing left to blend until something moves again
+			Set.PreviousTransforms = Set.Transforms;
+			Set.bInterpolating = false;
+		}
+
+		if (Set.bRenderStateDirty)
+		{
+			Set.Component->MarkRenderStateDirty();
+		}
+
+		Set.bTransformsDirty = false;
+		Set.bRenderStateDirty = false;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SimEntityHandle.h"
+#include "LifeSimRenderer.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+
+// Draws every organism, plant and food item as an instance of one
+// hierarchical instanced mesh per entity type. The color each actor used to
+// set on its own dynamic material goes into per-instance custom data instead.
+// Transform changes are collected during the frame and pushed once in Flush,
+// interpolated between the last two simulation steps so fixed steps look smooth.
+// Spawned on demand by ULifeSimSubsystem (lifesim.InstancedRendering).
+UCLASS(NotPlaceable)
+class THEMEANINGOFLIFE_API ALifeSimRenderer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ALifeSimRenderer();
+
+	// Material reading the instance color from PerInstanceCustomData[0..2].
+	// Without it every type falls back to one flat color and tints are not shown.
+	UPROPERTY(EditAnywhere, Category = "Rendering")
+	TSoftObjectPtr<UMaterialInterface> InstanceMaterial;
+
+	// Returns an id that stays valid until RemoveInstance, even as other instances come and go
+	int32 AddInstance(ESimEntityType Type, const FTransform& Transform, const FLinearColor& Color);
+	void RemoveInstance(ESimEntityType Type, int32 InstanceId);
+
+	// Batched, applied on the next Flush
+	void SetInstanceTransform(ESimEntityType Type, int32 InstanceId, const FTransform& Transform);
+	void SetInstanceColor(ESimEntityType Type, int32 InstanceId, const FLinearColor& Color);
+
+	// Called before the last simulation step of a frame. Instances that move
+	// in that step are drawn between where they were and where they end up.
+	void BeginInterpolation();
+
+	// Pushes this frame's changes to the render thread. Alpha is how far the
+	// frame is between the last step and the next one.
+	void Flush(float Alpha = 1.0f);
+
+	int32 GetInstanceCount(ESimEntityType Type) const;
+
+	// Instance data for one type: the mesh component's and the CPU copies kept here
+	SIZE_T GetInstanceAllocatedSize(ESimEntityType Type) const;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	static constexpr int32 NumCustomDataFloats = 3;
+
+	struct FInstanceSet
+	{
+		UHierarchicalInstancedStaticMeshComponent* Component = nullptr;
+
+		// CPU copy in instance order, so batches never read back from the component
+		TArray<FTransform> Transforms;
+
+		// Transforms at BeginInterpolation, and the blend actually drawn
+		TArray<FTransform> PreviousTransforms;
+		TArray<FTransform> DrawTransforms;
+
+		// Instance index <-> stable id
+		TArray<int32> IndexToId;
+		TArray<int32> IdToIndex;
+		TArray<int32> FreeIds;
+
+		bool bTransformsDirty = false;
+		bool bRenderStateDirty = false;
+
+		// Moved since BeginInterpolation, keep blending until Alpha reaches 1
+		bool bInterpolating = false;
+	};
+
+	FInstanceSet* GetInstanceSet(ESimEntityType Type);
+	void SetCustomColor(FInstanceSet& Set, int32 Index, const FLinearColor& Color);
+
+	UPROPERTY()
+	USceneComponent* Root;
+
+	UPROPERTY()
+	UHierarchicalInstancedStaticMeshComponent* OrganismInstances;
+
+	UPROPERTY()
+	UHierarchicalInstancedStaticMeshComponent* PlantInstances;
+
+	UPROPERTY()
+	UHierarchicalInstancedStaticMeshComponent* FoodInstances;
+
+	FInstanceSet InstanceSets[(int32)ESimEntityType::Count];
+};
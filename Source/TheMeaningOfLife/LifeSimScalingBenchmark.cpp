@@ -0,0 +1,280 @@
+#include "LifeSimScalingBenchmark.h"
+#include "LifeSimSubsystem.h"
+#include "EnvironmentManager.h"
+#include "ResourceComponent.h"
+#include "OrganismMassSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<float> CVarLifeSimBenchmarkWarmup(
+	TEXT("lifesim.Benchmark.WarmupSeconds"),
+	2.0f,
+	TEXT("Simulated seconds run after spawning each population before measuring."));
+
+static TAutoConsoleVariable<float> CVarLifeSimBenchmarkSeconds(
+	TEXT("lifesim.Benchmark.Seconds"),
+	10.0f,
+	TEXT("Simulated seconds measured for each population."));
+
+static TAutoConsoleVariable<float> CVarLifeSimBenchmarkPlantsPerOrganism(
+	TEXT("lifesim.Benchmark.PlantsPerOrganism"),
+	0.5f,
+	TEXT("Plants spawned for each organism in a benchmark population."));
+
+static FAutoConsoleCommandWithWorldAndArgs LifeSimBenchmarkCommand(
+	TEXT("lifesim.Benchmark"),
+	TEXT("Runs the population scaling benchmark, e.g. lifesim.Benchmark 100 1000 10000. Results go to Saved/Profiling/LifeSim."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		ULifeSimSubsystem* LifeSim = World ? World->GetSubsystem<ULifeSimSubsystem>() : nullptr;
+		if (!LifeSim)
+			return;
+
+		TArray<int32> OrganismCounts;
+		for (const FString& Arg : Args)
+		{
+			OrganismCounts.Add(FCString::Atoi(*Arg));
+		}
+		LifeSim->StartBenchmark(OrganismCounts);
+	}));
+
+// Nearest-rank percentile of a sorted array
+static float Percentile(const TArray<float>& Sorted, float Fraction)
+{
+	if (Sorted.Num() == 0)
+		return 0.0f;
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Index];
+}
+
+FLifeSimScalingBenchmark::FLifeSimScalingBenchmark()
+	: Stage(INDEX_NONE)
+	, bMeasuring(false)
+	, PhaseEndTime(0.0)
+	, MeasureStartTime(0.0)
+	, MeasureStartWallTime(0.0)
+	, SavedOrganismCap(0)
+	, SavedPlantCap(0)
+{
+}
+
+void FLifeSimScalingBenchmark::Start(ULifeSimSubsystem& LifeSim, const TArray<int32>& OrganismCounts)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Benchmark: already running"));
+		return;
+	}
+
+	const FLifeSimContext& Context = LifeSim.GetContext();
+	if (!Context.Environment)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark: no environment manager to spawn through"));
+		return;
+	}
+
+	Counts.Reset();
+	for (int32 Count : OrganismCounts)
+	{
+		if (Count > 0)
+		{
+			Counts.Add(Count);
+		}
+	}
+	if (Counts.Num() == 0)
+	{
+		Counts = { 100, 1000, 10000 };
+	}
+
+	if (Context.Resources)
+	{
+		SavedOrganismCap = Context.Resources->GetOrganismCap();
+		SavedPlantCap = Context.Resources->GetPlantCap();
+	}
+
+	Results.Reset();
+	Stage = 0;
+	BeginStage(LifeSim);
+}
+
+void FLifeSimScalingBenchmark::BeginStage(ULifeSimSubsystem& LifeSim)
+{
+	const FLifeSimContext& Context = LifeSim.GetContext();
+
+	Current = FStageResult();
+	Current.TargetOrganisms = Counts[Stage];
+	Current.TargetPlants = FMath::Max(FMath::RoundToInt(Counts[Stage] * CVarLifeSimBenchmarkPlantsPerOrganism.GetValueOnGameThread()), 1);
+	FrameTimes.Reset();
+
+	UE_LOG(LogTemp, Display, TEXT("Benchmark: %d organisms, %d plants"), Current.TargetOrganisms, Current.TargetPlants);
+
+	LifeSim.ClearPopulation();
+
+	// Caps at the target so births only replace deaths
+	if (Context.Resources)
+	{
+		Context.Resources->SetPopulationCaps(Current.TargetOrganisms, Current.TargetPlants);
+	}
+
+	if (Context.Environment)
+	{
+		Context.Environment->SpawnPlants(Current.TargetPlants);
+		Context.Environment->SpawnOrganisms(Current.TargetOrganisms);
+	}
+
+	// The spawn frame and the first steps after it are not measured
+	bMeasuring = false;
+	PhaseEndTime = LifeSim.GetSimulationTime() + CVarLifeSimBenchmarkWarmup.GetValueOnGameThread();
+}
+
+void FLifeSimScalingBenchmark::Tick(ULifeSimSubsystem& LifeSim, const FLifeSimFrameStats& Frame)
+{
+	if (!IsRunning())
+		return;
+
+	const double SimulationTime = LifeSim.GetSimulationTime();
+
+	if (!bMeasuring)
+	{
+		if (SimulationTime >= PhaseEndTime)
+		{
+			bMeasuring = true;
+			MeasureStartTime = SimulationTime;
+			MeasureStartWallTime = FPlatformTime::Seconds();
+			PhaseEndTime = SimulationTime + CVarLifeSimBenchmarkSeconds.GetValueOnGameThread();
+		}
+		return;
+	}
+
+	// Summed here, divided by the frame count when the stage ends
+	Current.Frames++;
+	Current.FrameMs += Frame.FrameMs;
+	Current.FrameMsMax = FMath::Max(Current.FrameMsMax, (double)Frame.FrameMs);
+	Current.StepsPerFrame += Frame.NumSteps;
+	Current.OrganismMs += Frame.OrganismMs;
+	Current.OrganismThreadMs += Frame.OrganismThreadMs;
+	Current.FoodQueryMs += Frame.FoodQueryMs;
+	Current.FoodQueries += Frame.FoodQueries;
+	Current.PlantMs += Frame.PlantMs;
+	Current.ResourceMs += Frame.ResourceMs;
+	Current.RenderMs += Frame.RenderMs;
+	Current.UiMs += Frame.UiMs;
+	Current.Organisms += Frame.Organisms;
+	Current.Plants += Frame.Plants;
+	Current.Food += Frame.Food;
+	FrameTimes.Add(Frame.FrameMs);
+
+	if (SimulationTime >= PhaseEndTime)
+	{
+		EndStage(LifeSim);
+
+		if (++Stage < Counts.Num())
+		{
+			BeginStage(LifeSim);
+		}
+		else
+		{
+			Finish(LifeSim);
+		}
+	}
+}
+
+void FLifeSimScalingBenchmark::EndStage(ULifeSimSubsystem& LifeSim)
+{
+	Current.SimulatedSeconds = LifeSim.GetSimulationTime() - MeasureStartTime;
+	Current.WallSeconds = FPlatformTime::Seconds() - MeasureStartWallTime;
+
+	const double Frames = FMath::Max(Current.Frames, 1);
+	Current.FrameMs /= Frames;
+	Current.StepsPerFrame /= Frames;
+	Current.OrganismMs /= Frames;
+	Current.OrganismThreadMs /= Frames;
+	Current.FoodQueryMs /= Frames;
+	Current.FoodQueries /= Frames;
+	Current.PlantMs /= Frames;
+	Current.ResourceMs /= Frames;
+	Current.RenderMs /= Frames;
+	Current.UiMs /= Frames;
+	Current.Organisms /= Frames;
+	Current.Plants /= Frames;
+	Current.Food /= Frames;
+
+	FrameTimes.Sort();
+	Current.FrameMsP50 = Percentile(FrameTimes, 0.5f);
+	Current.FrameMsP95 = Percentile(FrameTimes, 0.95f);
+
+	UE_LOG(LogTemp, Display, TEXT("Benchmark: %d organisms: %.2f ms/frame (p95 %.2f), organisms %.2f + %.2f thread, food %.2f, plants %.2f, render %.2f, ui %.2f"),
+		Current.TargetOrganisms, Current.FrameMs, Current.FrameMsP95, Current.OrganismMs, Current.OrganismThreadMs,
+		Current.FoodQueryMs, Current.PlantMs, Current.RenderMs, Current.UiMs);
+
+	Results.Add(Current);
+}
+
+void FLifeSimScalingBenchmark::Finish(ULifeSimSubsystem& LifeSim)
+{
+	Stage = INDEX_NONE;
+
+	// The last population stays, only the caps go back
+	if (UResourceComponent* Resources = LifeSim.GetContext().Resources)
+	{
+		Resources->SetPopulationCaps(SavedOrganismCap, SavedPlantCap);
+	}
+
+	WriteResults();
+}
+
+void FLifeSimScalingBenchmark::WriteResults() const
+{
+	const FString BaseName = FPaths::ProfilingDir() / TEXT("LifeSim") / FString::Printf(TEXT("Benchmark-%s"), *FDateTime::Now().ToString());
+
+	// One row per population, for plotting the scaling curve
+	FString Csv = TEXT("TargetOrganisms,TargetPlants,Frames,SimulatedSeconds,WallSeconds,FrameMs,FrameMsP50,FrameMsP95,FrameMsMax,StepsPerFrame,")
+		TEXT("OrganismMs,OrganismThreadMs,FoodQueryMs,FoodQueries,PlantMs,ResourceMs,RenderMs,UiMs,Organisms,Plants,Food\n");
+	for (const FStageResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%d,%.3f,%.3f,%.4f,%.4f,%.4f,%.4f,%.3f,%.4f,%.4f,%.4f,%.1f,%.4f,%.4f,%.4f,%.4f,%.1f,%.1f,%.1f\n"),
+			Result.TargetOrganisms, Result.TargetPlants, Result.Frames, Result.SimulatedSeconds, Result.WallSeconds,
+			Result.FrameMs, Result.FrameMsP50, Result.FrameMsP95, Result.FrameMsMax, Result.StepsPerFrame,
+			Result.OrganismMs, Result.OrganismThreadMs, Result.FoodQueryMs, Result.FoodQueries, Result.PlantMs,
+			Result.ResourceMs, Result.RenderMs, Result.UiMs, Result.Organisms, Result.Plants, Result.Food);
+	}
+
+	// Same numbers plus the settings they were taken with
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"fixedStepRate\": %.1f,\n"), 1.0f / ULifeSimSubsystem::GetFixedDeltaTime());
+	Json += FString::Printf(TEXT("\t\"warmupSeconds\": %.1f,\n"), CVarLifeSimBenchmarkWarmup.GetValueOnGameThread());
+	Json += FString::Printf(TEXT("\t\"measureSeconds\": %.1f,\n"), CVarLifeSimBenchmarkSeconds.GetValueOnGameThread());
+	Json += FString::Printf(TEXT("\t\"massOrganisms\": %s,\n"), UOrganismMassSubsystem::IsEnabled() ? TEXT("true") : TEXT("false"));
+	Json += FString::Printf(TEXT("\t\"headless\": %s,\n"), ULifeSimSubsystem::IsHeadless() ? TEXT("true") : TEXT("false"));
+	Json += TEXT("\t\"stages\": [\n");
+	for (int32 Index = 0; Index < Results.Num(); Index++)
+	{
+		const FStageResult& Result = Results[Index];
+		Json += FString::Printf(TEXT("\t\t{ \"targetOrganisms\": %d, \"targetPlants\": %d, \"frames\": %d, \"simulatedSeconds\": %.3f, \"wallSeconds\": %.3f, ")
+			TEXT("\"frameMs\": %.4f, \"frameMsP50\": %.4f, \"frameMsP95\": %.4f, \"frameMsMax\": %.4f, \"stepsPerFrame\": %.3f, ")
+			TEXT("\"organismMs\": %.4f, \"organismThreadMs\": %.4f, \"foodQueryMs\": %.4f, \"foodQueries\": %.1f, \"plantMs\": %.4f, ")
+			TEXT("\"resourceMs\": %.4f, \"renderMs\": %.4f, \"uiMs\": %.4f, \"organisms\": %.1f, \"plants\": %.1f, \"food\": %.1f }%s\n"),
+			Result.TargetOrganisms, Result.TargetPlants, Result.Frames, Result.SimulatedSeconds, Result.WallSeconds,
+			Result.FrameMs, Result.FrameMsP50, Result.FrameMsP95, Result.FrameMsMax, Result.StepsPerFrame,
+			Result.OrganismMs, Result.OrganismThreadMs, Result.FoodQueryMs, Result.FoodQueries, Result.PlantMs,
+			Result.ResourceMs, Result.RenderMs, Result.UiMs, Result.Organisms, Result.Plants, Result.Food,
+			Index + 1 < Results.Num() ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+
+	const bool bSaved = FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv")))
+		&& FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json")));
+
+	if (bSaved)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Benchmark: results written to %s.csv/.json"), *BaseName);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Benchmark: could not write %s"), *BaseName);
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LifeSimFrameStats.h"
+
+class ULifeSimSubsystem;
+
+// Population scaling benchmark (lifesim.Benchmark). For each organism count it
+// clears the world, spawns that many organisms and a matching share of plants
+// through the environment with the caps set to those counts, warms up, then
+// records frame stats for a fixed stretch of simulated time. The scaling curve
+// is written to Saved/Profiling/LifeSim as CSV and JSON.
+// Driven by ULifeSimSubsystem at the end of every frame, game thread only.
+class FLifeSimScalingBenchmark
+{
+public:
+	FLifeSimScalingBenchmark();
+
+	void Start(ULifeSimSubsystem& LifeSim, const TArray<int32>& OrganismCounts);
+	void Tick(ULifeSimSubsystem& LifeSim, const FLifeSimFrameStats& Frame);
+
+	bool IsRunning() const { return Stage != INDEX_NONE; }
+
+private:
+	// Averages over the measured frames of one count
+	struct FStageResult
+	{
+		int32 TargetOrganisms = 0;
+		int32 TargetPlants = 0;
+		int32 Frames = 0;
+		double SimulatedSeconds = 0.0;
+		double WallSeconds = 0.0;
+
+		double FrameMs = 0.0;
+		double FrameMsP50 = 0.0;
+		double FrameMsP95 = 0.0;
+		double FrameMsMax = 0.0;
+		double StepsPerFrame = 0.0;
+
+		double OrganismMs = 0.0;
+		double OrganismThreadMs = 0.0;
+		double FoodQueryMs = 0.0;
+		double FoodQueries = 0.0;
+		double PlantMs = 0.0;
+		double ResourceMs = 0.0;
+		double RenderMs = 0.0;
+		double UiMs = 0.0;
+
+		double Organisms = 0.0;
+		double Plants = 0.0;
+		double Food = 0.0;
+	};
+
+	void BeginStage(ULifeSimSubsystem& LifeSim);
+	void EndStage(ULifeSimSubsystem& LifeSim);
+	void Finish(ULifeSimSubsystem& LifeSim);
+	void WriteResults() const;
+
+	TArray<int32> Counts;
+	int32 Stage;
+
+	// Warming up until PhaseEndTime, then measuring until the next PhaseEndTime
+	bool bMeasuring;
+	double PhaseEndTime;
+	double MeasureStartTime;
+	double MeasureStartWallTime;
+
+	FStageResult Current;
+	TArray<float> FrameTimes;
+	TArray<FStageResult> Results;
+
+	// Put back when the benchmark ends
+	int32 SavedOrganismCap;
+	int32 SavedPlantCap;
+};
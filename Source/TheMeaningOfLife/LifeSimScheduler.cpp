@@ -0,0 +1,107 @@
+#include "LifeSimScheduler.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarLifeSimRatePlantLogic(
+	TEXT("lifesim.Rate.PlantLogic"),
+	1.0f,
+	TEXT("Plant water drain and food production updates per second. 0 updates every frame."));
+
+static TAutoConsoleVariable<float> CVarLifeSimRateOrganismSensing(
+	TEXT("lifesim.Rate.OrganismSensing"),
+	10.0f,
+	TEXT("Organism food searches per second. Organisms keep heading for their last target in between. 0 searches every step."));
+
+static TAutoConsoleVariable<float> CVarLifeSimRateOrganismMovement(
+	TEXT("lifesim.Rate.OrganismMovement"),
+	0.0f,
+	TEXT("Organism movement and metabolism updates per second. 0 updates every step, which keeps motion smooth."));
+
+static TAutoConsoleVariable<float> CVarLifeSimRateResourceAccounting(
+	TEXT("lifesim.Rate.ResourceAccounting"),
+	10.0f,
+	TEXT("Player energy and water updates per second. 0 updates every frame."));
+
+static TAutoConsoleVariable<float> CVarLifeSimRateWeather(
+	TEXT("lifesim.Rate.Weather"),
+	4.0f,
+	TEXT("Weather updates per second, each one waters the plants under every active rain. 0 updates every frame."));
+
+// Buckets per channel when it runs below frame rate. More buckets spread the work thinner.
+static constexpr int32 ChannelBuckets[(int32)ELifeSimChannel::Count] = {
+	8,	// PlantLogic
+	4,	// OrganismSensing
+	1,	// OrganismMovement
+	1,	// ResourceAccounting
+	1	// Weather
+};
+
+FLifeSimScheduler::FLifeSimScheduler()
+{
+}
+
+float FLifeSimScheduler::GetRate(ELifeSimChannel Channel)
+{
+	switch (Channel)
+	{
+	case ELifeSimChannel::PlantLogic:			return CVarLifeSimRatePlantLogic.GetValueOnGameThread();
+	case ELifeSimChannel::OrganismSensing:		return CVarLifeSimRateOrganismSensing.GetValueOnGameThread();
+	case ELifeSimChannel::OrganismMovement:		return CVarLifeSimRateOrganismMovement.GetValueOnGameThread();
+	case ELifeSimChannel::ResourceAccounting:	return CVarLifeSimRateResourceAccounting.GetValueOnGameThread();
+	case ELifeSimChannel::Weather:				return CVarLifeSimRateWeather.GetValueOnGameThread();
+	default:									return 0.0f;
+	}
+}
+
+void FLifeSimScheduler::Reset()
+{
+	for (FChannelState& State : Channels)
+	{
+		State = FChannelState();
+	}
+}
+
+void FLifeSimScheduler::Advance(ELifeSimChannel Channel, float DeltaTime, FLifeSimChannelFrame& OutFrame)
+{
+	FChannelState& State = Channels[(int32)Channel];
+	const double FrameStart = State.Time;
+	State.Time += DeltaTime;
+
+	const float Rate = GetRate(Channel);
+	const int32 NumBuckets = Rate > 0.0f ? ChannelBuckets[(int32)Channel] : 1;
+
+	// First frame, or the rate was switched on or off
+	if (State.BucketLastTimes.Num() != NumBuckets)
+	{
+		State.BucketLastTimes.Init(FrameStart, NumBuckets);
+		State.NextDueTime = State.Time;
+		State.NextBucket = 0;
+	}
+
+	OutFrame.BucketDeltas.Reset();
+	OutFrame.BucketDeltas.SetNumZeroed(NumBuckets);
+	OutFrame.bAnyDue = false;
+
+	if (Rate <= 0.0f)
+	{
+		OutFrame.BucketDeltas[0] = (float)(State.Time - State.BucketLastTimes[0]);
+		State.BucketLastTimes[0] = State.Time;
+		OutFrame.bAnyDue = true;
+		return;
+	}
+
+	// Buckets take turns, one every BucketInterval. After a long frame each
+	// bucket runs at most once, with all the time it missed.
+	const double BucketInterval = 1.0 / (Rate * NumBuckets);
+	for (int32 i = 0; i < NumBuckets && State.Time >= State.NextDueTime; i++)
+	{
+		const int32 Bucket = State.NextBucket;
+		OutFrame.BucketDeltas[Bucket] = (float)(State.Time - State.BucketLastTimes[Bucket]);
+		State.BucketLastTimes[Bucket] = State.Time;
+		State.NextBucket = (Bucket + 1) % NumBuckets;
+		State.NextDueTime += BucketInterval;
+		OutFrame.bAnyDue = true;
+	}
+
+	// Do not try to catch up on turns skipped during a hitch
+	State.NextDueTime = FMath::Max(State.NextDueTime, State.Time);
+}
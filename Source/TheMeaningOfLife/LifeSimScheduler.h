@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Parts of the simulation that run at their own rate
+enum class ELifeSimChannel : uint8
+{
+	PlantLogic,			// Water drain, tint and food production
+	OrganismSensing,	// Looking for food to eat or head for
+	OrganismMovement,	// Metabolism, reproduction and moving
+	ResourceAccounting,	// Player energy and water
+	Weather,			// Rain watering the plants under it
+	Count
+};
+
+// What one channel does this frame. Entities are split into buckets by a
+// stable key, and each bucket that is due gets the time since it last ran.
+struct FLifeSimChannelFrame
+{
+	// Accumulated delta per bucket, zero for buckets that are not due
+	TArray<float, TInlineAllocator<16>> BucketDeltas;
+
+	bool bAnyDue = false;
+
+	// Key must stay the same for the entity's whole life, e.g. its registry slot
+	float GetDelta(int32 Key) const
+	{
+		return BucketDeltas.Num() > 0 ? BucketDeltas[Key % BucketDeltas.Num()] : 0.0f;
+	}
+};
+
+// Decides which entities update on which frame. Each channel has a rate
+// (lifesim.Rate.*) and a number of buckets. A channel's buckets are spread
+// evenly over its period, so a 1 Hz channel with 8 buckets updates an eighth
+// of its entities every 125 ms instead of all of them once a second.
+// Game thread only. The frames it produces are plain data and can be handed
+// to the simulation thread.
+class FLifeSimScheduler
+{
+public:
+	FLifeSimScheduler();
+
+	// Moves the channel's clock forward and works out which buckets are due
+	void Advance(ELifeSimChannel Channel, float DeltaTime, FLifeSimChannelFrame& OutFrame);
+
+	// Updates per second, zero or less means every frame
+	static float GetRate(ELifeSimChannel Channel);
+
+	void Reset();
+
+private:
+	struct FChannelState
+	{
+		// Double so long sessions do not lose precision
+		double Time = 0.0;
+		double NextDueTime = 0.0;
+		int32 NextBucket = 0;
+		TArray<double, TInlineAllocator<16>> BucketLastTimes;
+	};
+
+	FChannelState Channels[(int32)ELifeSimChannel::Count];
+};
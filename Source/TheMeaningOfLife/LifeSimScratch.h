@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+// Transient simulation buffers (query results, candidate lists) live on the
+// calling thread's FMemStack, a linear arena every thread has its own of.
+// Allocating is a pointer bump with no locking, and everything allocated
+// inside a LIFESIM_SCRATCH_SCOPE is released together when the scope ends.
+//
+// The subsystem opens a scope around every frame, and code that fills a
+// scratch array off the game thread opens its own. Never keep one past the
+// scope it was made in.
+template<typename ElementType>
+using TLifeSimScratchArray = TArray<ElementType, TMemStackAllocator<>>;
+
+#define LIFESIM_SCRATCH_SCOPE() FMemMark PREPROCESSOR_JOIN(LifeSimScratchMark, __LINE__)(FMemStack::Get())
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Read-only view of the simulation, published once per completed step.
+// UI reads the latest one instead of reaching into simulation objects, so it
+// never has to wait for a step that is still running.
+struct FLifeSimSnapshot
+{
+	// Number of completed simulation steps, 0 until the first one is published
+	uint64 StepNumber = 0;
+	double SimulationTime = 0.0;
+
+	// Population
+	int32 OrganismCount = 0;
+	int32 OrganismCap = 0;
+	int32 PlantCount = 0;
+	int32 PlantCap = 0;
+	int32 FoodCount = 0;
+	int32 HungryOrganismCount = 0;
+	float AverageOrganismEnergy = 0.0f;
+
+	// Player resources
+	float Energy = 0.0f;
+	float MaxEnergy = 0.0f;
+	float Water = 0.0f;
+	float MaxWater = 0.0f;
+	int32 LifeEssence = 0;
+	int32 MaxLifeEssence = 0;
+
+	float GetEnergyPercent() const
+	{
+		return MaxEnergy > 0.0f ? Energy / MaxEnergy : 0.0f;
+	}
+
+	float GetWaterPercent() const
+	{
+		return MaxWater > 0.0f ? Water / MaxWater : 0.0f;
+	}
+};
@@ -0,0 +1,35 @@
+#include "LifeSimStats.h"
+
+DEFINE_STAT(STAT_LifeSim_Tick);
+DEFINE_STAT(STAT_LifeSim_Step);
+DEFINE_STAT(STAT_LifeSim_RunStep);
+DEFINE_STAT(STAT_LifeSim_CompleteStep);
+DEFINE_STAT(STAT_LifeSim_MassStep);
+DEFINE_STAT(STAT_LifeSim_UpdatePlants);
+DEFINE_STAT(STAT_LifeSim_UpdateResources);
+DEFINE_STAT(STAT_LifeSim_UpdateWeather);
+DEFINE_STAT(STAT_LifeSim_RenderFlush);
+
+DEFINE_STAT(STAT_LifeSim_OrganismSimulate);
+DEFINE_STAT(STAT_LifeSim_SeekFood);
+DEFINE_STAT(STAT_LifeSim_EatNearbyFood);
+DEFINE_STAT(STAT_LifeSim_FoodFromMemory);
+DEFINE_STAT(STAT_LifeSim_Boundaries);
+DEFINE_STAT(STAT_LifeSim_Reproduce);
+DEFINE_STAT(STAT_LifeSim_OrganismApply);
+
+DEFINE_STAT(STAT_LifeSim_PlantUpdate);
+DEFINE_STAT(STAT_LifeSim_PlantSpawnFood);
+DEFINE_STAT(STAT_LifeSim_FoodQuery);
+
+DEFINE_STAT(STAT_LifeSim_ResourceUI);
+DEFINE_STAT(STAT_LifeSim_SelectionUI);
+DEFINE_STAT(STAT_LifeSim_SpeedUI);
+
+DEFINE_STAT(STAT_LifeSim_Organisms);
+DEFINE_STAT(STAT_LifeSim_Plants);
+DEFINE_STAT(STAT_LifeSim_Food);
+DEFINE_STAT(STAT_LifeSim_Steps);
+DEFINE_STAT(STAT_LifeSim_FoodQueries);
+DEFINE_STAT(STAT_LifeSim_SpawnsPerSecond);
+DEFINE_STAT(STAT_LifeSim_DestroysPerSecond);
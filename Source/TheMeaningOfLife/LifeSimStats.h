@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// "stat LifeSim" in the console. Every scope also shows up as a CPU event in
+// Unreal Insights, through the stat when stats are compiled in and through a
+// plain trace scope when they are not.
+DECLARE_STATS_GROUP(TEXT("LifeSim"), STATGROUP_LifeSim, STATCAT_Advanced);
+
+#if STATS
+#define LIFESIM_SCOPE(Stat) SCOPE_CYCLE_COUNTER(Stat)
+#else
+#define LIFESIM_SCOPE(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
+#endif
+
+// Simulation subsystem
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_LifeSim_Tick, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Step"), STAT_LifeSim_Step, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Organism Step (sim thread)"), STAT_LifeSim_RunStep, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Complete Organism Step"), STAT_LifeSim_CompleteStep, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mass Organism Step"), STAT_LifeSim_MassStep, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Plants"), STAT_LifeSim_UpdatePlants, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Resources"), STAT_LifeSim_UpdateResources, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Weather"), STAT_LifeSim_UpdateWeather, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Renderer Flush"), STAT_LifeSim_RenderFlush, STATGROUP_LifeSim, );
+
+// Organisms, per organism and summed over every thread
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Simulate"), STAT_LifeSim_OrganismSimulate, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Seek Food"), STAT_LifeSim_SeekFood, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Eat Nearby Food"), STAT_LifeSim_EatNearbyFood, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Food From Memory"), STAT_LifeSim_FoodFromMemory, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Boundaries"), STAT_LifeSim_Boundaries, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Reproduce"), STAT_LifeSim_Reproduce, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Organism Apply Step"), STAT_LifeSim_OrganismApply, STATGROUP_LifeSim, );
+
+// Plants and food
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plant Update"), STAT_LifeSim_PlantUpdate, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plant Spawn Food"), STAT_LifeSim_PlantSpawnFood, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Food Query"), STAT_LifeSim_FoodQuery, STATGROUP_LifeSim, );
+
+// Player controller UI
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UI Resource Bars"), STAT_LifeSim_ResourceUI, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UI Selection"), STAT_LifeSim_SelectionUI, STATGROUP_LifeSim, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UI Simulation Speed"), STAT_LifeSim_SpeedUI, STATGROUP_LifeSim, );
+
+// Counters, set once per frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Organisms"), STAT_LifeSim_Organisms, STATGROUP_LifeSim, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Plants"), STAT_LifeSim_Plants, STATGROUP_LifeSim, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Food"), STAT_LifeSim_Food, STATGROUP_LifeSim, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Steps This Frame"), STAT_LifeSim_Steps, STATGROUP_LifeSim, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Food Queries This Frame"), STAT_LifeSim_FoodQueries, STATGROUP_LifeSim, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Spawns Per Second"), STAT_LifeSim_SpawnsPerSecond, STATGROUP_LifeSim, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Destroys Per Second"), STAT_LifeSim_DestroysPerSecond, STATGROUP_LifeSim, );
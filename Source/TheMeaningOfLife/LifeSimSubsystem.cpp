@@ -0,0 +1,844 @@
+#include "LifeSimSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "EnvironmentManager.h"
+#include "ResourceComponent.h"
+#include "OrganismActor.h"
+#include "PlantActor.h"
+#include "OrganismMassSubsystem.h"
+#include "LifeSimRenderer.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "LifeSimStats.h"
+#include "LifeSimAllocTracker.h"
+#include "LifeSimScratch.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+static TAutoConsoleVariable<bool> CVarLifeSimParallelOrganisms(
+	TEXT("lifesim.ParallelOrganisms"),
+	true,
+	TEXT("Step organisms across worker threads. When false they are stepped on the game thread, with the same results."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimSimulationThread(
+	TEXT("lifesim.SimulationThread"),
+	true,
+	TEXT("Run organism steps on a dedicated simulation thread, applying their results a frame later. When false each step runs and applies within the frame."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimMaxPendingFrames(
+	TEXT("lifesim.SimulationThread.MaxPendingFrames"),
+	4,
+	TEXT("Frames the game thread keeps going while a simulation step is still running before it waits for it."));
+
+static TAutoConsoleVariable<bool> CVarLifeSimInstancedRendering(
+	TEXT("lifesim.InstancedRendering"),
+	true,
+	TEXT("Draw organisms, plants and food as instances of one mesh per type. Read when each entity spawns."));
+
+static TAutoConsoleVariable<float> CVarLifeSimFixedStepRate(
+	TEXT("lifesim.FixedStep.Rate"),
+	20.0f,
+	TEXT("Simulation steps per simulated second. Every step covers the same time, whatever the speed or frame rate."));
+
+static TAutoConsoleVariable<int32> CVarLifeSimMaxStepsPerFrame(
+	TEXT("lifesim.FixedStep.MaxStepsPerFrame"),
+	64,
+	TEXT("Most simulation steps run in one frame. Time beyond that is dropped and the simulation reports that it is falling behind."));
+
+static FAutoConsoleCommandWithWorld LifeSimDumpFramesCommand(
+	TEXT("lifesim.DumpFrames"),
+	TEXT("Writes the recent frame history to Saved/Profiling/LifeSim, as a hitch would."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (ULifeSimSubsystem* LifeSim = World ? World->GetSubsystem<ULifeSimSubsystem>() : nullptr)
+		{
+			LifeSim->DumpFrameHistory();
+		}
+	}));
+
+static TAutoConsoleVariable<bool> CVarLifeSimFoodQueryStats(
+	TEXT("lifesim.Stats.FoodQueries"),
+	false,
+	TEXT("Count and time every food query for stat LifeSim and hitch dumps. Always on while the perf overlay or the scaling benchmark runs."));
+
+// Smallest number of organisms handed to one worker
+static constexpr int32 OrganismBatchSize = 32;
+
+ULifeSimSubsystem::ULifeSimSubsystem()
+	: MassOrganisms(nullptr)
+	, Renderer(nullptr)
+	, bSimulationThreadStarted(false)
+	, bStepInFlight(false)
+	, FramesSinceLaunch(0)
+	, SimulationSpeed(1.0f)
+	, StepAccumulator(0.0f)
+	, EffectiveSpeed(1.0f)
+	, bFallingBehind(false)
+	, StepEnvironment(nullptr)
+	, StepCount(0)
+	, SimulationTime(0.0)
+	, LastTickTime(0.0)
+	, RunStepCycles(0)
+	, RateWindowSeconds(0.0)
+	, RateWindowSpawns(0)
+	, RateWindowDestroys(0)
+	, SpawnsPerSecond(0.0f)
+	, DestroysPerSecond(0.0f)
+	, bPerfOverlayVisible(false)
+{
+}
+
+bool ULifeSimSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Only worlds that actually run the simulation
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULifeSimSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MassOrganisms = Collection.InitializeDependency<UOrganismMassSubsystem>();
+
+	FLifeSimAllocTracker::InstallIfRequested();
+}
+
+void ULifeSimSubsystem::Deinitialize()
+{
+	// The step in flight is dropped, the world is going away
+	SimulationThread.Shutdown();
+	bSimulationThreadStarted = false;
+	if (bStepInFlight && StepEnvironment)
+	{
+		StepEnvironment->EndFoodIndexRead();
+	}
+	bStepInFlight = false;
+	StepEnvironment = nullptr;
+
+	Context = FLifeSimContext();
+	Scheduler.Reset();
+	Weather.Reset();
+	MassOrganisms = nullptr;
+	Renderer = nullptr;
+	ActorPools.Empty();
+	OrganismUpdateList.Empty();
+	OrganismUpdateHandles.Empty();
+	OrganismCommands.Empty();
+
+	Slots.Empty();
+	FreeSlots.Empty();
+
+	for (int32 i = 0; i < (int32)ESimEntityType::Count; i++)
+	{
+		DenseEntities[i].Empty();
+		DenseSlots[i].Empty();
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId ULifeSimSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULifeSimSubsystem, STATGROUP_Tickables);
+}
+
+void ULifeSimSubsystem::Tick(float DeltaTime)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_Tick);
+
+	// Everything transient the frame leaves on the game thread's arena goes at once
+	LIFESIM_SCRATCH_SCOPE();
+
+	Super::Tick(DeltaTime);
+
+	const double TickStartTime = FPlatformTime::Seconds();
+	CurrentFrameStats.FrameMs = LastTickTime > 0.0 ? (TickStartTime - LastTickTime) * 1000.0 : 0.0;
+	LastTickTime = TickStartTime;
+
+	// Simulated time owed, always paid out in whole fixed steps
+	StepAccumulator += DeltaTime * SimulationSpeed;
+	const float FixedDeltaTime = GetFixedDeltaTime();
+
+	int32 NumSteps = 0;
+	if (bStepInFlight && !SimulationThread.IsIdle() && ++FramesSinceLaunch < CVarLifeSimMaxPendingFrames.GetValueOnGameThread())
+	{
+		// The simulation thread is still busy. Keep the frame going, the owed
+		// time is stepped once it catches up.
+	}
+	else
+	{
+		NumSteps = FMath::FloorToInt(StepAccumulator / FixedDeltaTime);
+
+		// Past the budget the frame rate would collapse, so the extra time is dropped instead
+		const int32 MaxSteps = FMath::Max(CVarLifeSimMaxStepsPerFrame.GetValueOnGameThread(), 1);
+		const bool bOverBudget = NumSteps > MaxSteps;
+		if (bOverBudget)
+		{
+			NumSteps = MaxSteps;
+			StepAccumulator = FMath::Fmod(StepAccumulator, FixedDeltaTime);
+		}
+		else
+		{
+			StepAccumulator -= NumSteps * FixedDeltaTime;
+		}
+
+		ReportFallingBehind(bOverBudget);
+	}
+
+	for (int32 Step = 0; Step < NumSteps; Step++)
+	{
+		// Moving instances are drawn between the last two steps of the frame
+		if (Renderer && Step == NumSteps - 1)
+		{
+			Renderer->BeginInterpolation();
+		}
+
+		StepSimulation(FixedDeltaTime);
+	}
+
+	// Speed actually reached, smoothed so the report does not flicker
+	if (DeltaTime > 0.0f)
+	{
+		const float FrameSpeed = (NumSteps * FixedDeltaTime) / DeltaTime;
+		EffectiveSpeed = FMath::Lerp(EffectiveSpeed, FrameSpeed, FMath::Min(DeltaTime * 2.0f, 1.0f));
+	}
+
+	// Everything that moved or changed color this frame goes out in one batch per type
+	if (Renderer)
+	{
+		LIFESIM_SCOPE(STAT_LifeSim_RenderFlush);
+		LIFESIM_ALLOC_SCOPE(Render);
+		const uint64 RenderStartCycles = FPlatformTime::Cycles64();
+		Renderer->Flush(StepAccumulator / FixedDeltaTime);
+		CurrentFrameStats.RenderMs += FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - RenderStartCycles);
+	}
+
+	// Close the frame's stats
+	if (Context.Environment)
+	{
+		double FoodQuerySeconds = 0.0;
+		Context.Environment->ConsumeFoodQueryStats(CurrentFrameStats.FoodQueries, FoodQuerySeconds);
+		CurrentFrameStats.FoodQueryMs = FoodQuerySeconds * 1000.0;
+		CurrentFrameStats.bFoodQueriesTracked = Context.Environment->IsTrackingFoodQueries();
+	}
+	if (FLifeSimAllocTracker::IsEnabled())
+	{
+		FLifeSimAllocTracker::ConsumeCounts(CurrentFrameStats.HeapAllocs);
+	}
+	CurrentFrameStats.FrameNumber = GFrameCounter;
+	CurrentFrameStats.NumSteps = NumSteps;
+	CurrentFrameStats.Organisms = GetCount(ESimEntityType::Organism);
+	CurrentFrameStats.Plants = GetCount(ESimEntityType::Plant);
+	CurrentFrameStats.Food = GetCount(ESimEntityType::Food);
+
+	PublishStats(CurrentFrameStats);
+
+	LastFrameStats = CurrentFrameStats;
+	CurrentFrameStats = FLifeSimFrameStats();
+
+	// The first frame has nothing to measure against
+	if (LastFrameStats.FrameMs > 0.0f)
+	{
+		HitchDetector.AddFrame(LastFrameStats);
+	}
+
+	Benchmark.Tick(*this, LastFrameStats);
+}
+
+void ULifeSimSubsystem::StepSimulation(float DeltaTime)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_Step);
+
+	// Apply the organism step before this one, then start this step's organisms
+	// on the simulation thread while the rest of the step runs here
+	const uint64 OrganismStartCycles = FPlatformTime::Cycles64();
+
+	if (bStepInFlight)
+	{
+		SimulationThread.Wait();
+		CompleteStep();
+	}
+
+	// Nothing reads the food index now. Counting queries is only paid for while something shows the count.
+	if (Context.Environment)
+	{
+		Context.Environment->SetTrackFoodQueries(CVarLifeSimFoodQueryStats.GetValueOnGameThread()
+			|| bPerfOverlayVisible || Benchmark.IsRunning());
+	}
+
+	LaunchStep(DeltaTime);
+
+	// Runs on the game thread, its chunks are spread over workers by Mass
+	if (MassOrganisms)
+	{
+		MassOrganisms->Step(DeltaTime, *this);
+	}
+
+	const uint64 PlantStartCycles = FPlatformTime::Cycles64();
+	UpdatePlants(DeltaTime);
+	UpdateWeather(DeltaTime);
+
+	const uint64 ResourceStartCycles = FPlatformTime::Cycles64();
+	UpdateResources(DeltaTime);
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	CurrentFrameStats.OrganismMs += FPlatformTime::ToMilliseconds64(PlantStartCycles - OrganismStartCycles);
+	CurrentFrameStats.PlantMs += FPlatformTime::ToMilliseconds64(ResourceStartCycles - PlantStartCycles);
+	CurrentFrameStats.ResourceMs += FPlatformTime::ToMilliseconds64(EndCycles - ResourceStartCycles);
+}
+
+void ULifeSimSubsystem::PublishStats(const FLifeSimFrameStats& Frame)
+{
+	// Churn is averaged over about a second, per frame it is mostly zero
+	RateWindowSpawns += Frame.Spawns;
+	RateWindowDestroys += Frame.Destroys;
+	RateWindowSeconds += Frame.FrameMs / 1000.0;
+	if (RateWindowSeconds >= 1.0)
+	{
+		SpawnsPerSecond = RateWindowSpawns / RateWindowSeconds;
+		DestroysPerSecond = RateWindowDestroys / RateWindowSeconds;
+		RateWindowSpawns = 0;
+		RateWindowDestroys = 0;
+		RateWindowSeconds = 0.0;
+	}
+
+	SET_DWORD_STAT(STAT_LifeSim_Organisms, Frame.Organisms);
+	SET_DWORD_STAT(STAT_LifeSim_Plants, Frame.Plants);
+	SET_DWORD_STAT(STAT_LifeSim_Food, Frame.Food);
+	SET_DWORD_STAT(STAT_LifeSim_Steps, Frame.NumSteps);
+	SET_DWORD_STAT(STAT_LifeSim_FoodQueries, Frame.FoodQueries);
+	SET_FLOAT_STAT(STAT_LifeSim_SpawnsPerSecond, SpawnsPerSecond);
+	SET_FLOAT_STAT(STAT_LifeSim_DestroysPerSecond, DestroysPerSecond);
+
+	// Same numbers as counter tracks in Insights
+	TRACE_INT_VALUE(TEXT("LifeSim/Organisms"), Frame.Organisms);
+	TRACE_INT_VALUE(TEXT("LifeSim/Plants"), Frame.Plants);
+	TRACE_INT_VALUE(TEXT("LifeSim/Food"), Frame.Food);
+	TRACE_INT_VALUE(TEXT("LifeSim/FoodQueries"), Frame.FoodQueries);
+	TRACE_FLOAT_VALUE(TEXT("LifeSim/SpawnsPerSecond"), SpawnsPerSecond);
+	TRACE_FLOAT_VALUE(TEXT("LifeSim/DestroysPerSecond"), DestroysPerSecond);
+}
+
+void ULifeSimSubsystem::AddUiTime(double Milliseconds)
+{
+	CurrentFrameStats.UiMs += Milliseconds;
+}
+
+void ULifeSimSubsystem::StartBenchmark(const TArray<int32>& OrganismCounts)
+{
+	Benchmark.Start(*this, OrganismCounts);
+}
+
+void ULifeSimSubsystem::ClearPopulation()
+{
+	// Organisms in the step in flight are released under it, their commands go stale
+	WaitForSimulationStep();
+
+	// Proxy actors of Mass organisms go with their entities
+	if (MassOrganisms)
+	{
+		MassOrganisms->DestroyAllOrganisms();
+	}
+
+	// Copies, releasing changes the dense arrays. Plants are not pooled and are destroyed.
+	LIFESIM_SCRATCH_SCOPE();
+	for (ESimEntityType Type : { ESimEntityType::Food, ESimEntityType::Plant, ESimEntityType::Organism })
+	{
+		const TLifeSimScratchArray<AActor*> Entities(GetEntities(Type));
+		for (AActor* Actor : Entities)
+		{
+			ReleaseActor(Actor);
+		}
+	}
+}
+
+void ULifeSimSubsystem::ReportFallingBehind(bool bOverBudget)
+{
+	if (bOverBudget == bFallingBehind)
+		return;
+
+	bFallingBehind = bOverBudget;
+	if (bFallingBehind)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Simulation is falling behind: %.0fx needs more than %d steps of %.0f ms per frame, running at about %.1fx"),
+			SimulationSpeed, CVarLifeSimMaxStepsPerFrame.GetValueOnGameThread(), GetFixedDeltaTime() * 1000.0f, EffectiveSpeed);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("Simulation caught up, running at %.0fx"), SimulationSpeed);
+	}
+}
+
+void ULifeSimSubsystem::SetSimulationSpeed(float Speed)
+{
+	SimulationSpeed = FMath::Max(Speed, 0.0f);
+}
+
+float ULifeSimSubsystem::GetFixedDeltaTime()
+{
+	return 1.0f / FMath::Max(CVarLifeSimFixedStepRate.GetValueOnGameThread(), 1.0f);
+}
+
+AActor* ULifeSimSubsystem::AcquireActor(UClass* Class, const FVector& Location)
+{
+	UWorld* World = GetWorld();
+	if (!Class || !World)
+		return nullptr;
+
+	if (FLifeSimActorPool* Pool = ActorPools.Find(Class))
+	{
+		while (Pool->Actors.Num() > 0)
+		{
+			// Anything destroyed while parked is skipped
+			AActor* Actor = Pool->Actors.Pop(EAllowShrinking::No);
+			if (!IsValid(Actor))
+				continue;
+
+			Actor->SetActorLocation(Location, false, nullptr, ETeleportType::ResetPhysics);
+			Actor->SetActorHiddenInGame(false);
+			Actor->SetActorEnableCollision(true);
+			Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+			CastChecked<IPooledActor>(Actor)->OnAcquiredFromPool();
+			return Actor;
+		}
+	}
+
+	// Pool is empty, BeginPlay sets the new actor up
+	FActorSpawnParameters SpawnParams;
+	return World->SpawnActor<AActor>(Class, Location, FRotator::ZeroRotator, SpawnParams);
+}
+
+void ULifeSimSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+		return;
+
+	IPooledActor* Pooled = Cast<IPooledActor>(Actor);
+	if (!Pooled)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	Pooled->OnReleasedToPool();
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	ActorPools.FindOrAdd(Actor->GetClass()).Actors.Add(Actor);
+}
+
+void ULifeSimSubsystem::PrewarmPool(UClass* Class, int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (!Class || !World || !Class->ImplementsInterface(UPooledActor::StaticClass()))
+		return;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// Spawned at the origin and parked right away, before anything ticks
+	for (int32 i = GetPooledCount(Class); i < Count; i++)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(Class, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+		if (!Actor)
+			return;
+
+		ReleaseActor(Actor);
+	}
+}
+
+int32 ULifeSimSubsystem::GetPooledCount(UClass* Class) const
+{
+	const FLifeSimActorPool* Pool = ActorPools.Find(Class);
+	return Pool ? Pool->Actors.Num() : 0;
+}
+
+ALifeSimRenderer* ULifeSimSubsystem::GetRenderer(bool bRequired)
+{
+	if (Renderer || IsHeadless() || (!bRequired && !CVarLifeSimInstancedRendering.GetValueOnGameThread()))
+		return Renderer;
+
+	UWorld* World = GetWorld();
+	if (!World)
+		return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	Renderer = World->SpawnActor<ALifeSimRenderer>(FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	return Renderer;
+}
+
+bool ULifeSimSubsystem::IsHeadless()
+{
+	return !FApp::CanEverRender();
+}
+
+const FLifeSimSnapshot& ULifeSimSubsystem::GetLatestSnapshot()
+{
+	if (Snapshots.IsDirty())
+	{
+		Snapshots.SwapReadBuffers();
+	}
+	return Snapshots.Read();
+}
+
+void ULifeSimSubsystem::WaitForSimulationStep()
+{
+	if (bStepInFlight)
+	{
+		SimulationThread.Wait();
+	}
+}
+
+void ULifeSimSubsystem::LaunchStep(float DeltaTime)
+{
+	{
+		LIFESIM_ALLOC_SCOPE(Organisms);
+
+		// Snapshot the organisms to step. Offspring spawned while applying
+		// register immediately but only start stepping with the next launch.
+		const TArray<AActor*>& Organisms = GetEntities(ESimEntityType::Organism);
+		const TArray<int32>& OrganismSlots = DenseSlots[(int32)ESimEntityType::Organism];
+		const int32 NumOrganisms = Organisms.Num();
+
+		OrganismUpdateList.Reset(NumOrganisms);
+		OrganismUpdateHandles.Reset(NumOrganisms);
+		for (int32 Index = 0; Index < NumOrganisms; Index++)
+		{
+			OrganismUpdateList.Add(static_cast<AOrganismActor*>(Organisms[Index]));
+			OrganismUpdateHandles.Add(FSimEntityHandle(OrganismSlots[Index], Slots[OrganismSlots[Index]].Generation));
+		}
+
+		OrganismCommands.Reset(NumOrganisms);
+		OrganismCommands.SetNum(NumOrganisms);
+
+		// Step time is what piled up since the last launch, so late steps still cover every second
+		Scheduler.Advance(ELifeSimChannel::OrganismMovement, DeltaTime, MovementFrame);
+		Scheduler.Advance(ELifeSimChannel::OrganismSensing, DeltaTime, SensingFrame);
+	}
+
+	// Food registered while the step runs is queued instead of touching the index
+	StepEnvironment = Context.Environment;
+	if (StepEnvironment)
+	{
+		StepEnvironment->BeginFoodIndexRead();
+	}
+
+	// Everything the snapshot needs from UObjects is read here, on the game thread
+	StepCount++;
+	SimulationTime += DeltaTime;
+
+	PendingStepState = FLifeSimSnapshot();
+	PendingStepState.StepNumber = StepCount;
+	PendingStepState.SimulationTime = SimulationTime;
+	PendingStepState.OrganismCount = GetCount(ESimEntityType::Organism);
+	PendingStepState.PlantCount = GetCount(ESimEntityType::Plant);
+	PendingStepState.FoodCount = GetCount(ESimEntityType::Food);
+	if (UResourceComponent* Resources = Context.Resources)
+	{
+		PendingStepState.OrganismCap = Resources->GetOrganismCap();
+		PendingStepState.PlantCap = Resources->GetPlantCap();
+		PendingStepState.Energy = Resources->Energy;
+		PendingStepState.MaxEnergy = Resources->MaxEnergy;
+		PendingStepState.Water = Resources->Water;
+		PendingStepState.MaxWater = Resources->MaxWater;
+		PendingStepState.LifeEssence = Resources->LifeEssence;
+		PendingStepState.MaxLifeEssence = Resources->MaxLifeEssence;
+	}
+
+	bStepInFlight = true;
+	FramesSinceLaunch = 0;
+
+	if (CVarLifeSimSimulationThread.GetValueOnGameThread() && !bSimulationThreadStarted)
+	{
+		bSimulationThreadStarted = SimulationThread.Start();
+	}
+
+	if (bSimulationThreadStarted && CVarLifeSimSimulationThread.GetValueOnGameThread())
+	{
+		SimulationThread.Kick(&ULifeSimSubsystem::RunStepOnThread, this);
+	}
+	else
+	{
+		// No simulation thread, run and apply the step within this frame
+		RunStep();
+		CompleteStep();
+	}
+}
+
+void ULifeSimSubsystem::RunStepOnThread(void* Subsystem)
+{
+	static_cast<ULifeSimSubsystem*>(Subsystem)->RunStep();
+}
+
+void ULifeSimSubsystem::RunStep()
+{
+	LIFESIM_SCOPE(STAT_LifeSim_RunStep);
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const int32 NumOrganisms = OrganismUpdateList.Num();
+
+	// Parallel phase: each organism only writes its own state and its own command slot
+	const EParallelForFlags Flags = CVarLifeSimParallelOrganisms.GetValueOnAnyThread()
+		? EParallelForFlags::None
+		: EParallelForFlags::ForceSingleThread;
+
+	// Dispatch is the task system's allocation and is not counted, see LifeSimAllocTracker.h
+	const float StepTime = (float)PendingStepState.SimulationTime;
+	ParallelFor(TEXT("LifeSim.StepOrganisms"), NumOrganisms, OrganismBatchSize, [this, StepTime](int32 Index)
+	{
+		// Scopes are per thread, each organism opens its own wherever it runs
+		LIFESIM_ALLOC_SCOPE(Organisms);
+
+		// Buckets are keyed on the registry slot, which an organism keeps for life
+		const int32 Key = OrganismUpdateHandles[Index].Index;
+
+		FOrganismStepDeltas Deltas;
+		Deltas.Movement = MovementFrame.GetDelta(Key);
+		Deltas.Sensing = SensingFrame.GetDelta(Key);
+		Deltas.Time = StepTime;
+
+		OrganismUpdateList[Index]->SimulateStep(Deltas, OrganismCommands[Index]);
+	}, Flags);
+
+	LIFESIM_ALLOC_SCOPE(Organisms);
+
+	// Publish what the step produced. The game thread picks it up whenever it next looks.
+	FLifeSimSnapshot& Snapshot = Snapshots.GetWriteBuffer();
+	Snapshot = PendingStepState;
+
+	// Actor organisms only, Mass organisms are not aggregated yet
+	float TotalEnergy = 0.0f;
+	for (const AOrganismActor* Organism : OrganismUpdateList)
+	{
+		TotalEnergy += Organism->Energy;
+		if (Organism->Energy < Organism->HungerThreshold)
+		{
+			Snapshot.HungryOrganismCount++;
+		}
+	}
+	Snapshot.AverageOrganismEnergy = NumOrganisms > 0 ? TotalEnergy / NumOrganisms : 0.0f;
+
+	Snapshots.SwapWriteBuffers();
+
+	RunStepCycles = FPlatformTime::Cycles64() - StartCycles;
+}
+
+void ULifeSimSubsystem::CompleteStep()
+{
+	LIFESIM_SCOPE(STAT_LifeSim_CompleteStep);
+	LIFESIM_ALLOC_SCOPE(Organisms);
+
+	bStepInFlight = false;
+	CurrentFrameStats.OrganismThreadMs += FPlatformTime::ToMilliseconds64(RunStepCycles);
+
+	// Replay food changes queued while the step was reading the index
+	if (StepEnvironment)
+	{
+		StepEnvironment->EndFoodIndexRead();
+		StepEnvironment = nullptr;
+	}
+
+	// Sync point: apply structural changes in registry order so the result
+	// (who gets contested food, which births fit under the cap) is deterministic.
+	// Organisms removed while the step ran have stale handles and are skipped.
+	for (int32 Index = 0; Index < OrganismUpdateList.Num(); Index++)
+	{
+		if (AOrganismActor* Organism = Resolve<AOrganismActor>(OrganismUpdateHandles[Index]))
+		{
+			Organism->ApplyStep(OrganismCommands[Index]);
+		}
+	}
+}
+
+void ULifeSimSubsystem::UpdatePlants(float DeltaTime)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_UpdatePlants);
+	LIFESIM_ALLOC_SCOPE(Plants);
+
+	Scheduler.Advance(ELifeSimChannel::PlantLogic, DeltaTime, PlantFrame);
+	if (!PlantFrame.bAnyDue)
+		return;
+
+	// Backwards, a plant that dies swaps an already updated plant into its place
+	const TArray<AActor*>& Plants = DenseEntities[(int32)ESimEntityType::Plant];
+	const TArray<int32>& PlantSlots = DenseSlots[(int32)ESimEntityType::Plant];
+	for (int32 Index = Plants.Num() - 1; Index >= 0; Index--)
+	{
+		if (Index >= Plants.Num())
+			continue;
+
+		const float PlantDeltaTime = PlantFrame.GetDelta(PlantSlots[Index]);
+		if (PlantDeltaTime > 0.0f)
+		{
+			static_cast<APlantActor*>(Plants[Index])->UpdatePlant(PlantDeltaTime);
+		}
+	}
+}
+
+void ULifeSimSubsystem::UpdateWeather(float DeltaTime)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_UpdateWeather);
+	LIFESIM_ALLOC_SCOPE(Plants);
+
+	Scheduler.Advance(ELifeSimChannel::Weather, DeltaTime, WeatherFrame);
+	if (!WeatherFrame.bAnyDue || !Context.Environment)
+		return;
+
+	Weather.Update(WeatherFrame.GetDelta(0), *Context.Environment, *this);
+}
+
+void ULifeSimSubsystem::UpdateResources(float DeltaTime)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_UpdateResources);
+	LIFESIM_ALLOC_SCOPE(Resources);
+
+	Scheduler.Advance(ELifeSimChannel::ResourceAccounting, DeltaTime, ResourceFrame);
+	if (ResourceFrame.bAnyDue && Context.Resources)
+	{
+		Context.Resources->UpdateResources(ResourceFrame.BucketDeltas[0]);
+	}
+}
+
+void ULifeSimSubsystem::RegisterResources(UResourceComponent* Resources)
+{
+	if (Context.Resources && Context.Resources != Resources)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("A second ResourceComponent registered with the simulation, replacing the first"));
+	}
+	Context.Resources = Resources;
+}
+
+void ULifeSimSubsystem::UnregisterResources(UResourceComponent* Resources)
+{
+	if (Context.Resources == Resources)
+	{
+		Context.Resources = nullptr;
+	}
+}
+
+void ULifeSimSubsystem::RegisterEnvironment(AEnvironmentManager* Environment)
+{
+	if (!Environment)
+		return;
+
+	// The running step reads the bounds
+	WaitForSimulationStep();
+
+	if (Context.Environment && Context.Environment != Environment)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("A second EnvironmentManager registered with the simulation, replacing the first"));
+	}
+	Context.Environment = Environment;
+
+	// Precompute the playable area once instead of per boundary check
+	const FVector Center = Environment->GetActorLocation();
+	const FVector2D HalfExtent(
+		(Environment->GridWidth * Environment->CellSize) / 2.0f,
+		(Environment->GridHeight * Environment->CellSize) / 2.0f);
+	Context.WorldBounds = FBox2D(FVector2D(Center) - HalfExtent, FVector2D(Center) + HalfExtent);
+}
+
+void ULifeSimSubsystem::UnregisterEnvironment(AEnvironmentManager* Environment)
+{
+	WaitForSimulationStep();
+
+	// Flush the queued food changes now, the step still applies as usual
+	if (StepEnvironment == Environment)
+	{
+		StepEnvironment->EndFoodIndexRead();
+		StepEnvironment = nullptr;
+	}
+
+	if (Context.Environment == Environment)
+	{
+		Context.Environment = nullptr;
+		Context.WorldBounds = FBox2D(ForceInit);
+	}
+}
+
+FSimEntityHandle ULifeSimSubsystem::RegisterEntity(AActor* Actor, ESimEntityType Type)
+{
+	if (!Actor || Type == ESimEntityType::Count)
+		return FSimEntityHandle();
+
+	CurrentFrameStats.Spawns++;
+
+	int32 SlotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		SlotIndex = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = Slots.AddDefaulted();
+	}
+
+	FEntitySlot& Slot = Slots[SlotIndex];
+	Slot.Actor = Actor;
+	Slot.Type = Type;
+	Slot.DenseIndex = DenseEntities[(int32)Type].Add(Actor);
+	DenseSlots[(int32)Type].Add(SlotIndex);
+
+	return FSimEntityHandle(SlotIndex, Slot.Generation);
+}
+
+void ULifeSimSubsystem::UnregisterEntity(FSimEntityHandle Handle)
+{
+	if (!IsValidHandle(Handle))
+		return;
+
+	CurrentFrameStats.Destroys++;
+
+	FEntitySlot& Slot = Slots[Handle.Index];
+	const int32 TypeIndex = (int32)Slot.Type;
+
+	// Swap the last live entity of this type into the hole
+	const int32 DenseIndex = Slot.DenseIndex;
+	DenseEntities[TypeIndex].RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	DenseSlots[TypeIndex].RemoveAtSwap(DenseIndex, 1, EAllowShrinking::No);
+	if (DenseIndex < DenseSlots[TypeIndex].Num())
+	{
+		Slots[DenseSlots[TypeIndex][DenseIndex]].DenseIndex = DenseIndex;
+	}
+
+	// Bumping the generation invalidates every outstanding handle to this slot
+	Slot.Actor = nullptr;
+	Slot.DenseIndex = INDEX_NONE;
+	Slot.Generation++;
+	FreeSlots.Add(Handle.Index);
+}
+
+bool ULifeSimSubsystem::IsValidHandle(FSimEntityHandle Handle) const
+{
+	return Slots.IsValidIndex(Handle.Index)
+		&& Slots[Handle.Index].Generation == Handle.Generation
+		&& Slots[Handle.Index].Actor != nullptr;
+}
+
+AActor* ULifeSimSubsystem::Resolve(FSimEntityHandle Handle) const
+{
+	return IsValidHandle(Handle) ? Slots[Handle.Index].Actor : nullptr;
+}
+
+int32 ULifeSimSubsystem::GetCount(ESimEntityType Type) const
+{
+	if (Type == ESimEntityType::Count)
+		return 0;
+
+	int32 Count = DenseEntities[(int32)Type].Num();
+	if (Type == ESimEntityType::Organism && MassOrganisms)
+	{
+		Count += MassOrganisms->GetOrganismCount();
+	}
+	return Count;
+}
+
+const TArray<AActor*>& ULifeSimSubsystem::GetEntities(ESimEntityType Type) const
+{
+	check(Type != ESimEntityType::Count);
+	return DenseEntities[(int32)Type];
+}
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimEntityHandle.h"
+#include "LifeSimContext.h"
+#include "LifeSimCommands.h"
+#include "LifeSimSnapshot.h"
+#include "LifeSimThread.h"
+#include "PooledActor.h"
+#include "LifeSimScheduler.h"
+#include "LifeSimFrameStats.h"
+#include "LifeSimScalingBenchmark.h"
+#include "LifeSimHitchDetector.h"
+#include "LifeSimWeather.h"
+#include "Containers/TripleBuffer.h"
+#include "LifeSimSubsystem.generated.h"
+
+class AOrganismActor;
+class UOrganismMassSubsystem;
+class ALifeSimRenderer;
+
+// Per-world registry of every live organism, plant and food actor.
+// Actors register on BeginPlay and unregister on EndPlay, so the registry is
+// the single source of truth for population counts and entity iteration.
+// Also owns the world's simulation context and steps all organisms in one batch,
+// on a dedicated simulation thread when one is available. The organism step only
+// overlaps the game thread's frame at one fixed step per frame or fewer. Each
+// further step in a frame first waits for the one before it, so at high speeds
+// the game thread still blocks once per extra step.
+UCLASS()
+class THEMEANINGOFLIFE_API ULifeSimSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULifeSimSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Simulation context. The address is stable for the lifetime of the world.
+	const FLifeSimContext& GetContext() const { return Context; }
+	void RegisterResources(UResourceComponent* Resources);
+	void UnregisterResources(UResourceComponent* Resources);
+	void RegisterEnvironment(AEnvironmentManager* Environment);
+	void UnregisterEnvironment(AEnvironmentManager* Environment);
+
+	// Registry
+	FSimEntityHandle RegisterEntity(AActor* Actor, ESimEntityType Type);
+	void UnregisterEntity(FSimEntityHandle Handle);
+	bool IsValidHandle(FSimEntityHandle Handle) const;
+	AActor* Resolve(FSimEntityHandle Handle) const;
+
+	template<typename T>
+	T* Resolve(FSimEntityHandle Handle) const
+	{
+		return Cast<T>(Resolve(Handle));
+	}
+
+	// Organism count includes organisms on the Mass backend
+	int32 GetCount(ESimEntityType Type) const;
+
+	// Densely packed live entities of one type. Order changes on unregister.
+	const TArray<AActor*>& GetEntities(ESimEntityType Type) const;
+
+	// Latest published snapshot of the simulation. Game thread only, never blocks.
+	const FLifeSimSnapshot& GetLatestSnapshot();
+
+	// Actor pools. Acquire reuses a parked actor of exactly that class or spawns a
+	// new one. Release parks IPooledActor actors and destroys anything else.
+	AActor* AcquireActor(UClass* Class, const FVector& Location);
+	void ReleaseActor(AActor* Actor);
+
+	template<typename T>
+	T* AcquireActor(TSubclassOf<T> Class, const FVector& Location)
+	{
+		return Cast<T>(AcquireActor(Class.Get(), Location));
+	}
+
+	// Spawns and parks actors until Count of Class are waiting in its pool
+	void PrewarmPool(UClass* Class, int32 Count);
+	int32 GetPooledCount(UClass* Class) const;
+
+	// Instanced renderer for every entity type, spawned on first use.
+	// Null when lifesim.InstancedRendering is off, actors then draw their own mesh.
+	// Callers with nothing else to draw with pass bRequired to spawn it regardless.
+	ALifeSimRenderer* GetRenderer(bool bRequired = false);
+	ALifeSimRenderer* GetRendererIfSpawned() const { return Renderer; }
+
+	// Simulated seconds per real second. The simulation always advances in
+	// fixed steps (lifesim.FixedStep.Rate), a higher speed runs more of them per frame.
+	void SetSimulationSpeed(float Speed);
+	float GetSimulationSpeed() const { return SimulationSpeed; }
+
+	// Speed actually reached lately. Lower than the requested one while falling behind.
+	float GetEffectiveSpeed() const { return EffectiveSpeed; }
+	bool IsFallingBehind() const { return bFallingBehind; }
+
+	static float GetFixedDeltaTime();
+
+	// Simulated seconds since the world started stepping
+	double GetSimulationTime() const { return SimulationTime; }
+	uint64 GetStepCount() const { return StepCount; }
+
+	// True when nothing will ever be drawn, e.g. the headless commandlet or a
+	// server build. Entities then skip instances, materials and debug drawing.
+	static bool IsHeadless();
+
+	// Timings of the last finished frame
+	const FLifeSimFrameStats& GetLastFrameStats() const { return LastFrameStats; }
+
+	// Writes the recent frame history now, as a hitch would (lifesim.DumpFrames)
+	void DumpFrameHistory() { HitchDetector.Dump(TEXT("Manual")); }
+
+	// UI work done for the simulation this frame, reported by the player controller
+	void AddUiTime(double Milliseconds);
+
+	// The overlay shows food query stats, which are only collected while something shows them
+	void SetPerfOverlayVisible(bool bVisible) { bPerfOverlayVisible = bVisible; }
+
+	// Debug shapes drawn this frame, game thread only
+	void AddDebugDraws(int32 Count) { CurrentFrameStats.DebugDraws += Count; }
+
+	// Entity churn averaged over about a second
+	float GetSpawnsPerSecond() const { return SpawnsPerSecond; }
+	float GetDestroysPerSecond() const { return DestroysPerSecond; }
+
+	// Population scaling benchmark, see FLifeSimScalingBenchmark. Replaces the population.
+	void StartBenchmark(const TArray<int32>& OrganismCounts);
+	bool IsBenchmarkRunning() const { return Benchmark.IsRunning(); }
+
+	// Rain that waters the plants under it for a while, see FLifeSimWeather
+	void AddRain(const FLifeSimRainEffect& Rain) { Weather.AddRain(Rain); }
+	const TArray<FLifeSimRainEffect>& GetRainEffects() const { return Weather.GetRainEffects(); }
+
+	// Removes every organism, plant and food, parking whatever is pooled
+	void ClearPopulation();
+
+	// Blocks until the organism step in flight (if any) has finished running.
+	// Anything the step reads must call this before it goes away.
+	void WaitForSimulationStep();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Advances everything by one fixed step. The organism part runs on the
+	// simulation thread and is applied at the start of the next step.
+	void StepSimulation(float DeltaTime);
+
+	// Sets the stat LifeSim counters and Insights counter tracks from a finished frame
+	void PublishStats(const FLifeSimFrameStats& Frame);
+
+	// Logs when the step budget starts and stops cutting simulated time
+	void ReportFallingBehind(bool bOverBudget);
+
+	// Gathers the organisms to step and hands them to the simulation thread
+	void LaunchStep(float DeltaTime);
+
+	// Runs on the simulation thread: steps every organism across worker
+	// threads and publishes a snapshot built on PendingStepState
+	void RunStep();
+	static void RunStepOnThread(void* Subsystem);
+
+	// Applies the recorded commands on the game thread in registry order
+	void CompleteStep();
+
+	// Plant, weather and resource updates that are due this frame
+	void UpdatePlants(float DeltaTime);
+	void UpdateWeather(float DeltaTime);
+	void UpdateResources(float DeltaTime);
+
+	FLifeSimContext Context;
+
+	// Organisms on the Mass backend, stepped right after the actor organisms
+	UPROPERTY()
+	UOrganismMassSubsystem* MassOrganisms;
+
+	UPROPERTY()
+	ALifeSimRenderer* Renderer;
+
+	UPROPERTY()
+	TMap<UClass*, FLifeSimActorPool> ActorPools;
+
+	// Organisms being stepped and the command buffer they record into.
+	// Kept between frames so steady-state updates reuse the allocations.
+	TArray<AOrganismActor*> OrganismUpdateList;
+	TArray<FSimEntityHandle> OrganismUpdateHandles;
+	TArray<FOrganismCommands> OrganismCommands;
+
+	// Which entities update on which frame, per channel
+	FLifeSimScheduler Scheduler;
+
+	// Organism channels for the step in flight, read by the simulation thread
+	FLifeSimChannelFrame MovementFrame;
+	FLifeSimChannelFrame SensingFrame;
+
+	FLifeSimChannelFrame PlantFrame;
+	FLifeSimChannelFrame ResourceFrame;
+	FLifeSimChannelFrame WeatherFrame;
+
+	FLifeSimWeather Weather;
+
+	FLifeSimThread SimulationThread;
+	bool bSimulationThreadStarted;
+
+	// Step state. The environment is kept so its food index read ends on the same actor.
+	bool bStepInFlight;
+	int32 FramesSinceLaunch;
+
+	// Fixed step state
+	float SimulationSpeed;
+	float StepAccumulator;
+	float EffectiveSpeed;
+	bool bFallingBehind;
+	class AEnvironmentManager* StepEnvironment;
+
+	uint64 StepCount;
+	double SimulationTime;
+
+	// Frame stats being filled in and the last finished ones
+	FLifeSimFrameStats CurrentFrameStats;
+	FLifeSimFrameStats LastFrameStats;
+	double LastTickTime;
+
+	// Written by the simulation thread, read once the step has been waited on
+	uint64 RunStepCycles;
+
+	// Spawn and destroy rates for stat LifeSim
+	double RateWindowSeconds;
+	int32 RateWindowSpawns;
+	int32 RateWindowDestroys;
+	float SpawnsPerSecond;
+	float DestroysPerSecond;
+
+	bool bPerfOverlayVisible;
+
+	FLifeSimScalingBenchmark Benchmark;
+	FLifeSimHitchDetector HitchDetector;
+
+	// Written by the simulation thread, read by the game thread
+	TTripleBuffer<FLifeSimSnapshot> Snapshots;
+
+	// What the game thread read for the step in flight, left alone until it completes
+	FLifeSimSnapshot PendingStepState;
+
+	struct FEntitySlot
+	{
+		AActor* Actor = nullptr;
+		uint32 Generation = 0;
+		ESimEntityType Type = ESimEntityType::Organism;
+		int32 DenseIndex = INDEX_NONE;
+	};
+
+	TArray<FEntitySlot> Slots;
+	TArray<int32> FreeSlots;
+
+	// Per type: live actors and the slot each of them occupies
+	TArray<AActor*> DenseEntities[(int32)ESimEntityType::Count];
+	TArray<int32> DenseSlots[(int32)ESimEntityType::Count];
+};
@@ -0,0 +1,122 @@
+#include "LifeSimThread.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+
+FLifeSimThread::FLifeSimThread()
+	: Thread(nullptr)
+	, WorkEvent(nullptr)
+	, IdleEvent(nullptr)
+	, StepFunction(nullptr)
+	, StepContext(nullptr)
+	, bBusy(false)
+	, bStopping(false)
+{
+}
+
+FLifeSimThread::~FLifeSimThread()
+{
+	Shutdown();
+}
+
+bool FLifeSimThread::Start()
+{
+	if (Thread)
+		return true;
+
+	if (!FPlatformProcess::SupportsMultithreading())
+		return false;
+
+	WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	IdleEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	IdleEvent->Trigger();
+	bStopping = false;
+
+	Thread = FRunnableThread::Create(this, TEXT("LifeSimThread"), 0, TPri_Normal);
+	if (!Thread)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		FPlatformProcess::ReturnSynchEventToPool(IdleEvent);
+		WorkEvent = nullptr;
+		IdleEvent = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void FLifeSimThread::Shutdown()
+{
+	if (!Thread)
+		return;
+
+	Wait();
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	FPlatformProcess::ReturnSynchEventToPool(IdleEvent);
+	WorkEvent = nullptr;
+	IdleEvent = nullptr;
+}
+
+void FLifeSimThread::Kick(FLifeSimStepFunction InStepFunction, void* InStepContext)
+{
+	check(Thread && IsIdle());
+
+	StepFunction = InStepFunction;
+	StepContext = InStepContext;
+	IdleEvent->Reset();
+	bBusy = true;
+	WorkEvent->Trigger();
+}
+
+bool FLifeSimThread::IsIdle() const
+{
+	return !bBusy.load(std::memory_order_acquire);
+}
+
+void FLifeSimThread::Wait()
+{
+	// bBusy is what counts, the event only saves spinning while the step runs
+	while (IdleEvent && bBusy.load(std::memory_order_acquire))
+	{
+		IdleEvent->Wait();
+	}
+}
+
+uint32 FLifeSimThread::Run()
+{
+	while (!bStopping)
+	{
+		WorkEvent->Wait();
+
+		if (bStopping)
+			break;
+
+		if (StepFunction)
+		{
+			StepFunction(StepContext);
+			StepFunction = nullptr;
+			StepContext = nullptr;
+		}
+
+		// Trigger first: once bBusy clears the game thread may Kick and reset the
+		// event, and a late Trigger would then wake Wait() in the middle of that step
+		IdleEvent->Trigger();
+		bBusy.store(false, std::memory_order_release);
+	}
+
+	return 0;
+}
+
+void FLifeSimThread::Stop()
+{
+	bStopping = true;
+	if (WorkEvent)
+	{
+		WorkEvent->Trigger();
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+
+// A step handed to the thread: a plain function and the object it runs on,
+// so kicking a step never allocates
+typedef void (*FLifeSimStepFunction)(void* StepContext);
+
+// Dedicated thread that runs one simulation step at a time, handed over by
+// the game thread. Between frames the game thread polls for completion instead
+// of waiting, so a slow step does not hold up input or rendering. Within a frame
+// that runs several steps, each one is waited on before the next is handed over.
+class FLifeSimThread : public FRunnable
+{
+public:
+	FLifeSimThread();
+	virtual ~FLifeSimThread();
+
+	// Creates the OS thread. Returns false if the platform cannot run one.
+	bool Start();
+
+	// Waits for the current step, then stops and joins the thread
+	void Shutdown();
+
+	// Game thread: hands a step to the thread. Only call while idle.
+	void Kick(FLifeSimStepFunction InStepFunction, void* InStepContext);
+
+	bool IsIdle() const;
+
+	// Blocks until the step handed over last has finished
+	void Wait();
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	FRunnableThread* Thread;
+	FEvent* WorkEvent;
+	FEvent* IdleEvent;
+	FLifeSimStepFunction StepFunction;
+	void* StepContext;
+	std::atomic<bool> bBusy;
+	std::atomic<bool> bStopping;
+};
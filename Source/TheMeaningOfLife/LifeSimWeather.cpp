@@ -0,0 +1,63 @@
+#include "LifeSimWeather.h"
+#include "EnvironmentManager.h"
+#include "LifeSimSubsystem.h"
+#include "LifeSimScratch.h"
+#include "PlantActor.h"
+
+void FLifeSimWeather::AddRain(const FLifeSimRainEffect& Rain)
+{
+	if (Rain.Radius <= 0.0f || Rain.TimeRemaining <= 0.0f)
+		return;
+
+	RainEffects.Add(Rain);
+}
+
+void FLifeSimWeather::Update(float DeltaTime, const AEnvironmentManager& Environment, ULifeSimSubsystem& LifeSim)
+{
+	if (RainEffects.Num() == 0 || DeltaTime <= 0.0f)
+		return;
+
+	// Overlapping rain adds up, each plant still gets a single AddWater
+	PendingWater.Reset();
+	for (const FLifeSimRainEffect& Rain : RainEffects)
+	{
+		LIFESIM_SCRATCH_SCOPE();
+
+		// The last update of a rain only covers what it had left
+		const float Water = Rain.WaterPerSecond * FMath::Min(DeltaTime, Rain.TimeRemaining);
+
+		TLifeSimScratchArray<FSimEntityHandle> Plants;
+		Environment.FindPlantsInRadius(Rain.Center, Rain.Radius, Plants);
+		for (const FSimEntityHandle& Plant : Plants)
+		{
+			PendingWater.FindOrAdd(Plant) += Water;
+		}
+	}
+
+	for (const TPair<FSimEntityHandle, float>& Pending : PendingWater)
+	{
+		if (APlantActor* Plant = LifeSim.Resolve<APlantActor>(Pending.Key))
+		{
+			Plant->AddWater(Pending.Value);
+		}
+	}
+
+	// Backwards, finished rain is swapped out
+	for (int32 i = RainEffects.Num() - 1; i >= 0; i--)
+	{
+		FLifeSimRainEffect& Rain = RainEffects[i];
+		Rain.TimeRemaining -= DeltaTime;
+		Rain.Center += Rain.Velocity * DeltaTime;
+
+		if (Rain.TimeRemaining <= 0.0f)
+		{
+			RainEffects.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		}
+	}
+}
+
+void FLifeSimWeather::Reset()
+{
+	RainEffects.Reset();
+	PendingWater.Reset();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimEntityHandle.h"
+
+class AEnvironmentManager;
+class ULifeSimSubsystem;
+
+// Rain over a circle of the map, watering every plant under it until it runs out.
+// A storm drifts with Velocity, a shower stays where it started.
+struct FLifeSimRainEffect
+{
+	FVector Center = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	float Radius = 500.0f;
+	float WaterPerSecond = 3.0f;
+	float TimeRemaining = 10.0f;
+};
+
+// The world's active weather. An update looks up only the plant index cells
+// under each effect, adds up what every plant gets from all of them, and then
+// waters each plant once. Cost follows the area rained on, not the plant count.
+// Game thread only, driven by ULifeSimSubsystem on the Weather channel.
+class FLifeSimWeather
+{
+public:
+	void AddRain(const FLifeSimRainEffect& Rain);
+
+	// Waters plants for DeltaTime of rain, then moves and expires the effects
+	void Update(float DeltaTime, const AEnvironmentManager& Environment, ULifeSimSubsystem& LifeSim);
+
+	const TArray<FLifeSimRainEffect>& GetRainEffects() const { return RainEffects; }
+
+	void Reset();
+
+private:
+	TArray<FLifeSimRainEffect> RainEffects;
+
+	// Water per plant for the update in progress. Kept so steady rain reuses the allocation.
+	TMap<FSimEntityHandle, float> PendingWater;
+};
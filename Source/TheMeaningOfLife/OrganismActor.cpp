@@ -7,13 +7,24 @@
 #include "Materials/Material.h"
 #include "FoodActor.h"
 #include "EnvironmentManager.h"
-#include "Kismet/GameplayStatics.h"
-#include "LifeSimPlayerController.h"
 #include "ResourceComponent.h"
+#include "LifeSimSubsystem.h"
+#include "OrganismMassTypes.h"
+#include "LifeSimDebugDraw.h"
+#include "LifeSimRules.h"
+#include "LifeSimRenderer.h"
+#include "LifeSimStats.h"
+#include "LifeSimMemory.h"
+
+static_assert(FFoodMemoryRing::Capacity == 4, "MaxFoodMemories' ClampMax has to match FFoodMemoryRing::Capacity");
+
+// A nice blue/purple for organisms
+static const FLinearColor OrganismColor(0.4f, 0.3f, 0.8f, 1.0f);
 
 AOrganismActor::AOrganismActor()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+	// Organisms are stepped in batches by ULifeSimSubsystem instead of ticking individually
+ 	PrimaryActorTick.bCanEverTick = false;
     
     OrganismName = TEXT(""); // Empty for now
     bIsSelected = false;
@@ -30,17 +41,12 @@ AOrganismActor::AOrganismActor()
 		MeshComponent->SetWorldScale3D(FVector(0.5f, 0.5f, 0.5f)); // Make it a reasonable size
 	}
 
-	// Load a basic material from the engine
+	// Load a basic material from the engine. It is only tinted in BeginPlay,
+	// and only when the organism draws its own mesh.
 	static ConstructorHelpers::FObjectFinder<UMaterial> Material(TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
 	if (Material.Succeeded())
 	{
-		UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(Material.Object, this);
-		if (DynMaterial)
-		{
-			// Set color to a nice blue/purple for organisms
-			DynMaterial->SetVectorParameterValue(FName("Color"), FLinearColor(0.4f, 0.3f, 0.8f, 1.0f));
-			MeshComponent->SetMaterial(0, DynMaterial);
-		}
+		MeshComponent->SetMaterial(0, Material.Object);
 	}
 
 	// Create energy bar widget
@@ -92,230 +98,376 @@ AOrganismActor::AOrganismActor()
 	DirectionChangeIntervalMin = 2.0f; // Change direction only after every 2 seconds
 	DirectionChangeIntervalMax = 5.0f; // Change direction at least every 5 seconds
 	DirectionChangeInterval = 0.0f;
+	SeekMode = EOrganismSeekMode::None;
+	SeekTarget = FVector::ZeroVector;
+
+	LifeSim = nullptr;
+	SimContext = nullptr;
+	Renderer = nullptr;
+	RenderInstance = INDEX_NONE;
 }
 
 // Called when the game starts or when spawned
 void AOrganismActor::BeginPlay()
 {
+	LIFESIM_LLM_SCOPE(Organisms);
 	Super::BeginPlay();
 	
 	// UE_LOG(LogTemp, Warning, TEXT("Organism spawned with %f energy"), Energy);
-	AddOrganism();
+	// Own stream so steps can run on worker threads
+	RandomStream.Initialize(FMath::Rand());
 
-	// Get Organism MetabolismRate
-	if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
+	// Mass proxies only mirror their entity, which is already drawn as an instance
+	if (IsMassProxy())
 	{
-		if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
-		{
-			MetabolismRate = Resources->GetOrganismMetabolismRate();
-		}
+		MeshComponent->SetHiddenInGame(true);
+		return;
+	}
+
+	LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+	if (LifeSim)
+	{
+		SimContext = &LifeSim->GetContext();
+		Renderer = LifeSim->GetRenderer();
 	}
+
+	if (Renderer)
+	{
+		// Drawn as an instance, the mesh stays around for selection traces
+		MeshComponent->SetHiddenInGame(true);
+	}
+	else if (ULifeSimSubsystem::IsHeadless())
+	{
+		// Nothing is drawn, keep the shared material
+	}
+	else if (UMaterialInstanceDynamic* DynMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamic(0))
+	{
+		DynMaterial->SetVectorParameterValue(FName("Color"), OrganismColor);
+	}
+
+	JoinSimulation();
 }
 
-// Called every frame
-void AOrganismActor::Tick(float DeltaTime)
+void AOrganismActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	// Parked organisms have already left
+	LeaveSimulation();
 
-	// Consume energy over time (metabolism)
-	float MetabolismAmount = MetabolismRate * DeltaTime;
-	Energy -= MetabolismAmount;
+	Super::EndPlay(EndPlayReason);
+}
 
-	Age += DeltaTime;
-	TimeSinceLastReproduction += DeltaTime;
+void AOrganismActor::OnAcquiredFromPool()
+{
+	// Back to what a freshly spawned organism of this class starts with
+	const AOrganismActor* Defaults = GetClass()->GetDefaultObject<AOrganismActor>();
+	Energy = Defaults->Energy;
+	Age = 0.0f;
+	TimeSinceLastReproduction = ReproductionCooldown;
+	FoodMemories.Reset();
 
-	// If selected, update the EnergyBar
+	CurrentMovementDirection = FVector::ZeroVector;
+	TimeSinceDirectionChange = 0.0f;
+	DirectionChangeInterval = 0.0f;
+	SeekMode = EOrganismSeekMode::None;
+	RandomStream.Initialize(FMath::Rand());
+
+	JoinSimulation();
+}
+
+void AOrganismActor::OnReleasedToPool()
+{
+	// Nobody gets to keep a parked organism selected
 	if (bIsSelected)
 	{
-		UpdateEnergyBar();
+		OnDeselected();
 	}
 
-	UpdateFoodMemories(DeltaTime);
+	LeaveSimulation();
+}
 
-	// Check if organism dies
-	if (Energy <= 0.0f)
-	{
-		Die();
+void AOrganismActor::JoinSimulation()
+{
+	if (!LifeSim)
 		return;
+
+	SimHandle = LifeSim->RegisterEntity(this, ESimEntityType::Organism);
+
+	// Get Organism MetabolismRate
+	if (SimContext->Resources)
+	{
+		MetabolismRate = SimContext->Resources->GetOrganismMetabolismRate();
+	}
+
+	if (Renderer)
+	{
+		RenderInstance = Renderer->AddInstance(ESimEntityType::Organism, MeshComponent->GetComponentTransform(), OrganismColor);
+	}
+}
+
+void AOrganismActor::LeaveSimulation()
+{
+	if (LifeSim && SimHandle.IsSet())
+	{
+		// The simulation thread may still be stepping us
+		LifeSim->WaitForSimulationStep();
+		LifeSim->UnregisterEntity(SimHandle);
+		SimHandle.Reset();
+	}
+
+	if (Renderer && RenderInstance != INDEX_NONE)
+	{
+		Renderer->RemoveInstance(ESimEntityType::Organism, RenderInstance);
+		RenderInstance = INDEX_NONE;
 	}
+}
 
-	// Try to eat nearby food first
-	if (TryEatNearbyFood())
+void AOrganismActor::SimulateStep(const FOrganismStepDeltas& Deltas, FOrganismCommands& OutCommands)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_OrganismSimulate);
+
+	// Runs on a worker thread: only touch our own state and read-only world data.
+	// Anything that changes the world is recorded into OutCommands instead.
+	// Each part runs only when the scheduler says it is due for this organism.
+	const float DeltaTime = Deltas.Movement;
+
+	if (DeltaTime > 0.0f)
 	{
-		return; // Eating takes this frame
+		// Consume energy over time (metabolism)
+		Energy = LifeSimRules::Metabolize(Energy, MetabolismRate, DeltaTime);
+
+		Age += DeltaTime;
+		TimeSinceLastReproduction += DeltaTime;
+
+		// Check if organism dies
+		if (LifeSimRules::IsStarved(Energy))
+		{
+			OutCommands.bDie = true;
+			return;
+		}
 	}
 
+	FVector Location = GetActorLocation();
+
+	if (Deltas.Sensing > 0.0f)
+	{
+		// Try to eat nearby food first
+		if (TryEatNearbyFood(Location, OutCommands))
+		{
+			return; // Eating takes this step
+		}
+
+		// Pick what to head for until the next look around
+		UpdateSeekTarget(Location, Deltas.Time);
+	}
+
+	if (DeltaTime <= 0.0f)
+		return;
+
 	// Try to reproduce if conditions are met
-	TryReproduce();
+	TryReproduce(OutCommands);
 
 	// Check boundaries before moving
-	CheckAndHandleBoundaries();
+	CheckAndHandleBoundaries(Location);
 
-	// If hungry, seek food. Otherwise wander randomly
-	if (Energy < HungerThreshold)
+	// If hungry, head for the food we last saw or remembered. Otherwise wander randomly
+	if (LifeSimRules::IsHungry(Energy, HungerThreshold) && SeekMode != EOrganismSeekMode::None)
 	{
-		SeekFood(DeltaTime);
+		LifeSimRules::MoveToward(Location, SeekTarget, MovementSpeed, DeltaTime);
+
+		OutCommands.bSeeking = true;
+		OutCommands.SeekMode = SeekMode;
+		OutCommands.SeekTarget = SeekTarget;
 	}
 	else
 	{
-		MoveRandomly(DeltaTime);
+		MoveRandomly(DeltaTime, Location);
 	}
-}
 
-void AOrganismActor::Die()
-{
-	// UE_LOG(LogTemp, Warning, TEXT("Organism died at age %f"), Age);
-	RemoveOrganism();
-	Destroy();
+	OutCommands.bMoved = true;
+	OutCommands.NewLocation = Location;
 }
 
-void AOrganismActor::AddOrganism()
+void AOrganismActor::ApplyStep(const FOrganismCommands& Commands)
 {
-	// Add 1 Organism to the ResourceComponent's OrganismCount
-	if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
+	LIFESIM_SCOPE(STAT_LifeSim_OrganismApply);
+
+	// If selected, update the EnergyBar
+	if (bIsSelected)
 	{
-		if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
-		{
-			bool bOrganismAdded = Resources->AddOrganism();
-			if (!bOrganismAdded)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Organism can't be added"));
-			}
-		}
+		UpdateEnergyBar();
 	}
-}
 
-void AOrganismActor::RemoveOrganism()
-{
-	// Remove 1 Organism from the ResourceComponent's OrganismCount
-	if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
+	if (Commands.bDie)
 	{
-		if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
+		Die();
+		return;
+	}
+
+	if (Commands.FoodToEat.IsSet())
+	{
+		EatFood(Commands.FoodToEat, Commands.FoodLocation);
+		return;
+	}
+
+	if (Commands.bReproduce)
+	{
+		SpawnOffspring(Commands.OffspringDirection);
+	}
+
+	if (Commands.bMoved)
+	{
+		SetActorLocation(Commands.NewLocation);
+
+		if (Renderer)
 		{
-			bool bOrganismRemoved = Resources->RemoveOrganism();
-			if (!bOrganismRemoved)
-			{
-				UE_LOG(LogTemp, Warning, TEXT("Organism can't be removed"));
-			}
+			Renderer->SetInstanceTransform(ESimEntityType::Organism, RenderInstance, MeshComponent->GetComponentTransform());
 		}
 	}
+
+#if ENABLE_DRAW_DEBUG
+	if (Commands.bSeeking && FLifeSimDebugDraw::ShouldDraw(*this, bIsSelected, DetectionRadius))
+	{
+		DrawSeekDebug(Commands);
+	}
+#endif
 }
 
-void AOrganismActor::MoveRandomly(float DeltaTime)
+void AOrganismActor::SyncFromMass(const FOrganismVitalsFragment& Vitals, const FVector& Location, const FOrganismMemoryFragment& Memory)
 {
-	TimeSinceDirectionChange += DeltaTime;
+	Energy = Vitals.Energy;
+	MaxEnergy = Vitals.MaxEnergy;
+	MetabolismRate = Vitals.MetabolismRate;
+	Age = Vitals.Age;
+	MovementSpeed = Vitals.MovementSpeed;
+	MemoryDecayTime = Memory.MemoryDecayTime;
+	FoodMemories = Memory.FoodMemories;
 
-	// Pick a new direction if enough time has passed or we don't have one yet
-	if (TimeSinceDirectionChange >= DirectionChangeInterval || CurrentMovementDirection.IsZero())
-	{
-		CurrentMovementDirection = FVector(
-			FMath::RandRange(-1.0f, 1.0f),
-			FMath::RandRange(-1.0f, 1.0f),
-			0.0f // Keep movement on horizontal plane
-		).GetSafeNormal();
+	SetActorLocation(Location);
 
-		TimeSinceDirectionChange = 0.0f;
+	if (bIsSelected)
+	{
+		UpdateEnergyBar();
+	}
+}
 
-		// Pick a random length between interval min and max
-		DirectionChangeInterval = FMath::RandRange(DirectionChangeIntervalMin, DirectionChangeIntervalMax);
+void AOrganismActor::Die()
+{
+	// UE_LOG(LogTemp, Warning, TEXT("Organism died at age %f"), Age);
+	// Parked for the next birth instead of destroyed
+	if (LifeSim)
+	{
+		LifeSim->ReleaseActor(this);
+		return;
 	}
+	Destroy();
+}
 
-	// Move in the current direction
-	FVector NewLocation = GetActorLocation() + (CurrentMovementDirection * MovementSpeed * DeltaTime);
-	SetActorLocation(NewLocation);
+void AOrganismActor::MoveRandomly(float DeltaTime, FVector& Location)
+{
+	LifeSimRules::Wander(CurrentMovementDirection, TimeSinceDirectionChange, DirectionChangeInterval,
+		DirectionChangeIntervalMin, DirectionChangeIntervalMax, RandomStream, MovementSpeed, DeltaTime, Location);
 }
 
-void AOrganismActor::SeekFood(float DeltaTime)
+void AOrganismActor::UpdateSeekTarget(const FVector& Location, float Now)
 {
-	// Draw detection radius
-	DrawDebugSphere(GetWorld(), GetActorLocation(), DetectionRadius, 16, FColor::Red, false, -1.0f, 0, 2.0f);
+	LIFESIM_SCOPE(STAT_LifeSim_SeekFood);
+
+	SeekMode = EOrganismSeekMode::None;
+
+	// Only hungry organisms go looking
+	if (!LifeSimRules::IsHungry(Energy, HungerThreshold))
+		return;
 
 	// First, try to go to a remembered food location
-	AActor* RememberedFood = FindFoodFromMemory();
-	if (RememberedFood)
+	FVector FoodLocation;
+	if (FindFoodFromMemory(Now, FoodLocation))
 	{
-		FVector Direction = (RememberedFood->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-		FVector NewLocation = GetActorLocation() + (Direction * MovementSpeed * DeltaTime);
-		SetActorLocation(NewLocation);
-
-		// Draw green line to show we're using memory
-		DrawDebugLine(GetWorld(), GetActorLocation(), RememberedFood->GetActorLocation(),
-			FColor::Cyan, false, -1.0f, 0, 2.0f);
+		SeekMode = EOrganismSeekMode::Memory;
+		SeekTarget = FoodLocation;
 		return;
 	}
 
-	// If no memory, search normally
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AFoodActor::StaticClass(), FoundActors);
+	// If no memory, search the cells within detection radius for the closest food
+	AEnvironmentManager* Environment = SimContext ? SimContext->Environment : nullptr;
+	FSimEntityHandle ClosestFood;
 
-	if (FoundActors.Num() == 0)
+	if (Environment && Environment->FindNearestFood(Location, DetectionRadius, ClosestFood, FoodLocation))
 	{
-		// No food found, wander randomly
-		MoveRandomly(DeltaTime);
-		return;
+		SeekMode = EOrganismSeekMode::Sight;
+		SeekTarget = FoodLocation;
 	}
+	// No food in range, wander until the next look
+}
 
-	// Find the closest food within detection radius
-	AActor* ClosestFood = nullptr;
-	float ClosestDistance = DetectionRadius;
+#if ENABLE_DRAW_DEBUG
+void AOrganismActor::DrawSeekDebug(const FOrganismCommands& Commands)
+{
+	int32 Draws = 0;
 
-	for (AActor* Food : FoundActors)
+	// Draw detection radius, flat since organisms only move on the ground
+	if (FLifeSimDebugDraw::IsEnabled(ELifeSimDebugCategory::DetectionRadius))
 	{
-		float Distance = FVector::Dist(GetActorLocation(), Food->GetActorLocation());
-		if (Distance < ClosestDistance)
-		{
-			ClosestDistance = Distance;
-			ClosestFood = Food;
-		}
+		DrawDebugCircle(GetWorld(), GetActorLocation(), DetectionRadius, 32, FColor::Red, false, -1.0f, 0, 2.0f,
+			FVector::ForwardVector, FVector::RightVector, false);
+		Draws++;
 	}
 
-	if (ClosestFood)
+	if (Commands.SeekMode == EOrganismSeekMode::Memory && FLifeSimDebugDraw::IsEnabled(ELifeSimDebugCategory::MemoryTarget))
+	{
+		// Draw cyan line to show we're using memory
+		DrawDebugLine(GetWorld(), GetActorLocation(), Commands.SeekTarget,
+			FColor::Cyan, false, -1.0f, 0, 2.0f);
+		Draws++;
+	}
+	else if (Commands.SeekMode == EOrganismSeekMode::Sight && FLifeSimDebugDraw::IsEnabled(ELifeSimDebugCategory::SeekTarget))
 	{
 		// Draw a debug line so we can see it seeking
-		DrawDebugLine(GetWorld(), GetActorLocation(), ClosestFood->GetActorLocation(),
+		DrawDebugLine(GetWorld(), GetActorLocation(), Commands.SeekTarget,
 			FColor::Green, false, -1.0f, 0, 2.0f);
-
-		// Move toward the closest food
-		FVector Direction = (ClosestFood->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-		FVector NewLocation = GetActorLocation() + (Direction * MovementSpeed * DeltaTime);
-		SetActorLocation(NewLocation);
+		Draws++;
 	}
-	else
+
+	if (LifeSim)
 	{
-		// No food in range, wander
-		MoveRandomly(DeltaTime);
+		LifeSim->AddDebugDraws(Draws);
 	}
 }
+#endif
 
-bool AOrganismActor::TryEatNearbyFood()
+bool AOrganismActor::TryEatNearbyFood(const FVector& Location, FOrganismCommands& OutCommands)
 {
-	// Find all food actors in the world
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AFoodActor::StaticClass(), FoundActors);
-	
-	for (AActor* Actor : FoundActors)
-	{
-		float Distance = FVector::Dist(GetActorLocation(), Actor->GetActorLocation());
+	LIFESIM_SCOPE(STAT_LifeSim_EatNearbyFood);
 
-		// If food is very close (within 50 units), eat it
-		if (Distance < 50.0f)
-		{
-			AFoodActor* Food = Cast<AFoodActor>(Actor);
-			if (Food)
-			{
-				// Remember this location before eating
-				RememberFoodLocation(Food->GetActorLocation());
-
-				Energy = FMath::Min(Energy + Food->EnergyValue, MaxEnergy);
-				// UE_LOG(LogTemp, Warning, TEXT("Organism ate food! Energy now: %f"), Energy);
-				Food->Consume();
-				return true;
-			}
-		}
+	if (!SimContext || !SimContext->Environment)
+		return false;
+
+	// If food is very close, claim it. It is eaten at the sync point.
+	FSimEntityHandle Food;
+	FVector FoodLocation;
+	if (SimContext->Environment->FindNearestFood(Location, LifeSimRules::EatRadius, Food, FoodLocation))
+	{
+		OutCommands.FoodToEat = Food;
+		OutCommands.FoodLocation = FoodLocation;
+		return true;
 	}
 	return false;
 }
 
+void AOrganismActor::EatFood(FSimEntityHandle FoodHandle, const FVector& FoodLocation)
+{
+	// Stale if an organism earlier in this step already ate it
+	AFoodActor* Food = LifeSim ? LifeSim->Resolve<AFoodActor>(FoodHandle) : nullptr;
+	if (!Food)
+		return;
+
+	// Remember this location before eating
+	RememberFoodLocation(FoodLocation);
+
+	Energy = LifeSimRules::Eat(Energy, Food->EnergyValue, MaxEnergy);
+	// UE_LOG(LogTemp, Warning, TEXT("Organism ate food! Energy now: %f"), Energy);
+	Food->Consume();
+}
+
 void AOrganismActor::UpdateEnergyBar()
 {
 	if (EnergyBarWidget && EnergyBarWidget->GetWidget())
@@ -333,84 +485,41 @@ void AOrganismActor::UpdateEnergyBar()
 	}
 }
 
-bool AOrganismActor::CheckAndHandleBoundaries()
+bool AOrganismActor::CheckAndHandleBoundaries(FVector& Location)
 {
-	// Find the environment manager
-	AEnvironmentManager* EnvManager = nullptr;
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnvironmentManager::StaticClass(), FoundActors);
+	LIFESIM_SCOPE(STAT_LifeSim_Boundaries);
 
-	if (FoundActors.Num() > 0)
-	{
-		EnvManager = Cast<AEnvironmentManager>(FoundActors[0]);
-	}
-
-	if (!EnvManager)
+	// Bounds are precomputed from the environment grid
+	if (!SimContext || !SimContext->HasWorldBounds())
 		return false;
 
-	FVector Location = GetActorLocation();
-	FVector ManagerLocation = EnvManager->GetActorLocation();
-
-	float HalfGridWidth = (EnvManager->GridWidth * EnvManager->CellSize) / 2.0f;
-	float HalfGridHeight = (EnvManager->GridHeight * EnvManager->CellSize) / 2.0f;
-
-	bool HitBoundary = false;
-
-	// Check X boundaries
-	if (Location.X < ManagerLocation.X - HalfGridWidth)
-	{
-		Location.X = ManagerLocation.X - HalfGridWidth;
-		CurrentMovementDirection.X = FMath::Abs(CurrentMovementDirection.X); // Bounce right
-		HitBoundary = true;
-	}
-	else if (Location.X > ManagerLocation.X + HalfGridWidth)
-	{
-		Location.X = ManagerLocation.X + HalfGridWidth;
-		CurrentMovementDirection.X = -FMath::Abs(CurrentMovementDirection.X); // Bounce left
-		HitBoundary = true;
-	}
-
-	// Check Y boundaries
-	if (Location.Y < ManagerLocation.Y - HalfGridHeight)
-	{
-		Location.Y = ManagerLocation.Y - HalfGridHeight;
-		CurrentMovementDirection.Y = FMath::Abs(CurrentMovementDirection.Y); // Bounce up
-		HitBoundary = true;
-	}
-	else if (Location.Y > ManagerLocation.Y + HalfGridHeight)
-	{
-		Location.Y = ManagerLocation.Y + HalfGridHeight;
-		CurrentMovementDirection.Y = -FMath::Abs(CurrentMovementDirection.Y); // Bounce down
-		HitBoundary = true;
-	}
-
-	if (HitBoundary)
-	{
-		SetActorLocation(Location);
-		CurrentMovementDirection.Normalize();
-	}
-
-	return HitBoundary;
+	return LifeSimRules::ReflectOffBounds(SimContext->WorldBounds, Location, CurrentMovementDirection);
 }
 
-void AOrganismActor::TryReproduce()
+void AOrganismActor::TryReproduce(FOrganismCommands& OutCommands)
 {
+	LIFESIM_SCOPE(STAT_LifeSim_Reproduce);
+
 	// Check if we have enough energy and cooldown is done
-	if (Energy < ReproductionThreshold || TimeSinceLastReproduction < ReproductionCooldown)
+	if (!LifeSimRules::CanReproduce(Energy, ReproductionThreshold, TimeSinceLastReproduction, ReproductionCooldown))
 	{
 		return;
 	}
 
-	// Check if an organism can spawn
-	if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
+	// Spawn offspring nearby
+	OutCommands.bReproduce = true;
+	OutCommands.OffspringDirection = LifeSimRules::RandomPlanarDirection(RandomStream);
+}
+
+void AOrganismActor::SpawnOffspring(const FVector& OffsetDirection)
+{
+	// Check if an organism can spawn. Earlier spawns in this step are already counted.
+	if (SimContext && SimContext->Resources)
 	{
-		if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
+		bool bCanSpawnOrganism = SimContext->Resources->CanSpawnOrganism();
+		if (!bCanSpawnOrganism)
 		{
-			bool bCanSpawnOrganism = Resources->CanSpawnOrganism();
-			if (!bCanSpawnOrganism)
-			{
-				return;
-			}
+			return;
 		}
 	}
 
@@ -418,23 +527,12 @@ void AOrganismActor::TryReproduce()
 	Energy -= ReproductionCost;
 	TimeSinceLastReproduction = 0.0f;
 
-	// Spawn offspring nearby
-	FVector OffsetDirection = FVector(
-		FMath::RandRange(-1.0f, 1.0f),
-		FMath::RandRange(-1.0f, 1.0f),
-		0.0f
-	).GetSafeNormal();
-
-	FVector SpawnLocation = GetActorLocation() + (OffsetDirection * 100.0f); // 100 units away
+	FVector SpawnLocation = GetActorLocation() + (OffsetDirection * LifeSimRules::OffspringDistance);
 	SpawnLocation.Z = ReproductionSpawnOffset; // Spawn slightly above ground
 	
-	FActorSpawnParameters SpawnParams;
-	AOrganismActor* Offspring = GetWorld()->SpawnActor<AOrganismActor>(
-		AOrganismActor::StaticClass(),
-		SpawnLocation,
-		FRotator::ZeroRotator,
-		SpawnParams
-	);
+	// Same class as the parent, so births reuse the organisms that died
+	LIFESIM_LLM_SCOPE(Organisms);
+	AOrganismActor* Offspring = LifeSim->AcquireActor<AOrganismActor>(GetClass(), SpawnLocation);
 
 	if (Offspring)
 	{
@@ -445,69 +543,29 @@ void AOrganismActor::TryReproduce()
 	}
 }
 
-void AOrganismActor::UpdateFoodMemories(float DeltaTime)
-{
-	// Age all memories
-	for (int32 i = FoodMemories.Num() - 1; i >= 0; i--)
-	{
-		FoodMemories[i].TimeSinceFound += DeltaTime;
-
-		// Forget old memories
-		if (FoodMemories[i].TimeSinceFound > MemoryDecayTime)
-		{
-			FoodMemories.RemoveAt(i);
-		}
-	}
-}
-
 void AOrganismActor::RememberFoodLocation(FVector Location)
 {
-	// Check if we already remember this location (nearby)
-	for (FFoodMemory& Memory : FoodMemories)
-	{
-		if (FVector::Dist(Memory.Location, Location) < 100.0f)
-		{
-			// Refresh this memory
-			Memory.TimeSinceFound = 0.0f;
-			return;
-		}
-	}
-
-	// Add new memory
-	FoodMemories.Add(FFoodMemory(Location));
-
-	// Forget oldest if too many
-	if (FoodMemories.Num() > MaxFoodMemories)
-	{
-		FoodMemories.RemoveAt(0);
-	}
+	const AEnvironmentManager* Environment = SimContext ? SimContext->Environment : nullptr;
+	if (!Environment || !LifeSim)
+		return;
 
-	// UE_LOG(LogTemp, Log, TEXT("Organism remembered location! Total memories: %d"), FoodMemories.Num());
+	FoodMemories.Remember(Environment->GetFoodCell(Location), (float)LifeSim->GetSimulationTime(), MemoryDecayTime, MaxFoodMemories);
 }
 
-AActor* AOrganismActor::FindFoodFromMemory()
+bool AOrganismActor::FindFoodFromMemory(float Now, FVector& OutFoodLocation) const
 {
-	if (FoodMemories.Num() == 0)
-		return nullptr;
+	LIFESIM_SCOPE(STAT_LifeSim_FoodFromMemory);
 
-	// Find all food in the world
-	TArray<AActor*> AllFood;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AFoodActor::StaticClass(), AllFood);
+	if (!SimContext || !SimContext->Environment)
+		return false;
 
-	// Check each memory to see if food still exists there
-	for (FFoodMemory& Memory : FoodMemories)
+	// If there is still food in a remembered cell, go there!
+	const AEnvironmentManager* Environment = SimContext->Environment;
+	return FoodMemories.FindFood(Now, MemoryDecayTime, [Environment, &OutFoodLocation](const FIntPoint& Cell)
 	{
-		for (AActor* Food : AllFood)
-		{
-			// If food is near a remembered location, go there!
-			if (FVector::Dist(Food->GetActorLocation(), Memory.Location) < 150.0f)
-			{
-				return Food;
-			}
-		}
-	}
-
-	return nullptr;
+		FSimEntityHandle Food;
+		return Environment->FindFoodInCell(Cell, Food, OutFoodLocation);
+	});
 }
 
 void AOrganismActor::OnSelected()
@@ -535,6 +593,12 @@ void AOrganismActor::OnDeselected()
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Organism deselected"));
+
+	// The entity carries on without its proxy
+	if (IsMassProxy())
+	{
+		Destroy();
+	}
 }
 
 FString AOrganismActor::GetDisplayName()
@@ -546,15 +610,15 @@ FString AOrganismActor::GetDisplayName()
 	return OrganismName;
 }
 
-TArray<TPair<FString, FString>> AOrganismActor::GetDisplayInfo()
+void AOrganismActor::GetDisplayProperties(TArray<FSelectableProperty>& OutProperties)
 {
-	TArray<TPair<FString, FString>> Info;
-
-	Info.Add(TPair<FString, FString>(TEXT("Energy"), FString::Printf(TEXT("%.1f / %.1f"), Energy, MaxEnergy)));
-	Info.Add(TPair<FString, FString>(TEXT("Age"), FString::Printf(TEXT("%.1f seconds"), Age)));
-	Info.Add(TPair<FString, FString>(TEXT("Metabolism"), FString::Printf(TEXT("%.2f/s"), MetabolismRate)));
-	Info.Add(TPair<FString, FString>(TEXT("Movement Speed"), FString::Printf(TEXT("%.0f"), MovementSpeed)));
-	Info.Add(TPair<FString, FString>(TEXT("Food Memories"), FString::Printf(TEXT("%d"), FoodMemories.Num())));
-
-	return Info;
+	// Mass proxies are not registered, so look the subsystem up for the memory count
+	const ULifeSimSubsystem* Sim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+
+	OutProperties.Add(FSelectableProperty::Ratio(TEXT("Energy"), Energy, MaxEnergy, 1));
+	OutProperties.Add(FSelectableProperty::Number(TEXT("Age"), Age, 1, TEXT(" seconds")));
+	OutProperties.Add(FSelectableProperty::Number(TEXT("Metabolism"), MetabolismRate, 2, TEXT("/s")));
+	OutProperties.Add(FSelectableProperty::Number(TEXT("Movement Speed"), MovementSpeed, 0));
+	OutProperties.Add(FSelectableProperty::Count(TEXT("Food Memories"),
+		Sim ? FoodMemories.NumRemembered((float)Sim->GetSimulationTime(), MemoryDecayTime) : 0));
 }
\ No newline at end of file
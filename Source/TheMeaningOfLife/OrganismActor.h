@@ -3,40 +3,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Selectable.h"
+#include "PooledActor.h"
+#include "SimEntityHandle.h"
+#include "LifeSimCommands.h"
+#include "MassEntityTypes.h"
+#include "FoodMemoryRing.h"
 #include "OrganismActor.generated.h"
 
-// Struct to store memories of food locations
-USTRUCT(BlueprintType)
-struct FFoodMemory
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	FVector Location;
-
-	UPROPERTY()
-	float TimeSinceFound;
-
-	UPROPERTY()
-	bool bStillExists;
-
-	FFoodMemory()
-		: Location(FVector::ZeroVector)
-		, TimeSinceFound(0.0f)
-		, bStillExists(true)
-	{
-	}
-
-	FFoodMemory(FVector InLocation)
-		: Location(InLocation)
-		, TimeSinceFound(0.0f)
-		, bStillExists(true)
-	{
-	}
-};
-
 UCLASS()
-class THEMEANINGOFLIFE_API AOrganismActor : public AActor, public ISelectable
+class THEMEANINGOFLIFE_API AOrganismActor : public AActor, public ISelectable, public IPooledActor
 {
 	GENERATED_BODY()
 	
@@ -47,13 +22,18 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Selectable interface implementation
 	virtual void OnSelected() override;
 	virtual void OnDeselected() override;
 	virtual FString GetDisplayName() override;
-	virtual TArray<TPair<FString, FString>> GetDisplayInfo() override;
+	virtual void GetDisplayProperties(TArray<FSelectableProperty>& OutProperties) override;
+
+	// Pooled actor interface implementation
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism")
 	FString OrganismName; // We'll add naming later, for now it can be empty
@@ -61,8 +41,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism")
 	bool bIsSelected;
 
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	// Advances this organism by one step. Safe to run on a worker thread:
+	// world changes are recorded into OutCommands instead of being made.
+	// Parts that are not due this step (zero delta) are skipped.
+	void SimulateStep(const FOrganismStepDeltas& Deltas, FOrganismCommands& OutCommands);
+
+	// Applies the commands recorded by SimulateStep. Game thread only.
+	void ApplyStep(const FOrganismCommands& Commands);
+
+	// Mass backend: this actor is only a selection proxy for a Mass entity.
+	// Set before BeginPlay. Proxies are not registered or stepped, they mirror the entity.
+	void SetMassEntity(FMassEntityHandle InMassEntity) { MassEntity = InMassEntity; }
+	bool IsMassProxy() const { return MassEntity.IsSet(); }
+	void SyncFromMass(const struct FOrganismVitalsFragment& Vitals, const FVector& Location, const struct FOrganismMemoryFragment& Memory);
 
 	// Core properties
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism")
@@ -107,25 +98,48 @@ public:
 	class UWidgetComponent* EnergyBarWidget;
 
 	// Memory properties
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism|Memory")
+	// ClampMax is FFoodMemoryRing::Capacity, checked in OrganismActor.cpp
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism|Memory", meta = (ClampMin = "1", ClampMax = "4"))
 	int32 MaxFoodMemories; // How many locations to remember
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Organism|Memory")
 	float MemoryDecayTime; // How long before forgetting a location
 
 private:
+	// Registry entry and render instance, from BeginPlay or leaving the pool until EndPlay or parking
+	void JoinSimulation();
+	void LeaveSimulation();
+
 	void Die();
-	void MoveRandomly(float DeltaTime);
-	void SeekFood(float DeltaTime);
-	bool TryEatNearbyFood();
+	void MoveRandomly(float DeltaTime, FVector& Location);
+	void UpdateSeekTarget(const FVector& Location, float Now);
+	void DrawSeekDebug(const FOrganismCommands& Commands); // Development builds only
+	bool TryEatNearbyFood(const FVector& Location, FOrganismCommands& OutCommands);
+	void EatFood(FSimEntityHandle FoodHandle, const FVector& FoodLocation);
 	void UpdateEnergyBar();
-	bool CheckAndHandleBoundaries();
-	void TryReproduce();
-	void UpdateFoodMemories(float DeltaTime);
+	bool CheckAndHandleBoundaries(FVector& Location);
+	void TryReproduce(FOrganismCommands& OutCommands);
+	void SpawnOffspring(const FVector& OffsetDirection);
 	void RememberFoodLocation(FVector Location);
-	void AddOrganism();
-	void RemoveOrganism();
-	AActor* FindFoodFromMemory();
+	bool FindFoodFromMemory(float Now, FVector& OutFoodLocation) const;
+
+	// Registry entry, valid between BeginPlay and EndPlay
+	UPROPERTY()
+	class ULifeSimSubsystem* LifeSim;
+
+	FSimEntityHandle SimHandle;
+
+	// Entity this actor stands in for, unset for regular organisms
+	FMassEntityHandle MassEntity;
+
+	// World-wide simulation state, owned by LifeSim
+	const struct FLifeSimContext* SimContext;
+
+	// Instance drawn in place of MeshComponent, unset when the organism draws itself
+	UPROPERTY()
+	class ALifeSimRenderer* Renderer;
+
+	int32 RenderInstance;
 
 	// Movement state
 	FVector CurrentMovementDirection;
@@ -134,9 +148,16 @@ private:
 	float DirectionChangeIntervalMin;
 	float DirectionChangeIntervalMax;
 
+	// Food picked by the last sensing update, followed until the next one
+	EOrganismSeekMode SeekMode;
+	FVector SeekTarget;
+
 	// Reproduction state
 	float TimeSinceLastReproduction;
 
-	// Memory state
-	TArray<FFoodMemory> FoodMemories;
+	// Per-organism random stream, FMath::Rand is not safe on worker threads
+	FRandomStream RandomStream;
+
+	// Memory state, inline and stamped with simulation time so it never needs updating
+	FFoodMemoryRing FoodMemories;
 };
@@ -0,0 +1,117 @@
+#include "OrganismMassProcessors.h"
+#include "OrganismMassTypes.h"
+#include "MassExecutionContext.h"
+#include "LifeSimContext.h"
+#include "EnvironmentManager.h"
+#include "LifeSimRules.h"
+#include "LifeSimAllocTracker.h"
+
+UOrganismStepProcessor::UOrganismStepProcessor()
+	: EntityQuery(*this)
+	, SimContext(nullptr)
+	, SimulationTime(0.0f)
+{
+	// Driven by UOrganismMassSubsystem, there is no Mass simulation phase in this project
+	bAutoRegisterWithProcessingPhases = false;
+	bRequiresGameThreadExecution = false;
+}
+
+void UOrganismStepProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FOrganismVitalsFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FOrganismLocationFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FOrganismMovementFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FOrganismReproductionFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FOrganismMemoryFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FOrganismCommandFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FOrganismMassTag>(EMassFragmentPresence::All);
+}
+
+void UOrganismStepProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const AEnvironmentManager* Environment = SimContext ? SimContext->Environment : nullptr;
+	const bool bHasBounds = SimContext && SimContext->HasWorldBounds();
+	const float Now = SimulationTime;
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [Environment, bHasBounds, Now, this](FMassExecutionContext& ChunkContext)
+	{
+		// Scopes are per thread, each chunk opens its own wherever it runs
+		LIFESIM_ALLOC_SCOPE(Organisms);
+
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+		const int32 NumEntities = ChunkContext.GetNumEntities();
+
+		const TArrayView<FOrganismVitalsFragment> VitalsList = ChunkContext.GetMutableFragmentView<FOrganismVitalsFragment>();
+		const TArrayView<FOrganismLocationFragment> LocationList = ChunkContext.GetMutableFragmentView<FOrganismLocationFragment>();
+		const TArrayView<FOrganismMovementFragment> MovementList = ChunkContext.GetMutableFragmentView<FOrganismMovementFragment>();
+		const TArrayView<FOrganismReproductionFragment> ReproductionList = ChunkContext.GetMutableFragmentView<FOrganismReproductionFragment>();
+		const TArrayView<FOrganismMemoryFragment> MemoryList = ChunkContext.GetMutableFragmentView<FOrganismMemoryFragment>();
+		const TArrayView<FOrganismCommandFragment> CommandList = ChunkContext.GetMutableFragmentView<FOrganismCommandFragment>();
+
+		for (int32 EntityIndex = 0; EntityIndex < NumEntities; EntityIndex++)
+		{
+			FOrganismVitalsFragment& Vitals = VitalsList[EntityIndex];
+			FOrganismMovementFragment& Movement = MovementList[EntityIndex];
+			FOrganismReproductionFragment& Reproduction = ReproductionList[EntityIndex];
+			FOrganismMemoryFragment& Memory = MemoryList[EntityIndex];
+			FOrganismCommands& Commands = CommandList[EntityIndex].Commands;
+			FVector& Location = LocationList[EntityIndex].Location;
+
+			Commands.Reset();
+
+			// Metabolism and aging
+			Vitals.Energy = LifeSimRules::Metabolize(Vitals.Energy, Vitals.MetabolismRate, DeltaTime);
+			Vitals.Age += DeltaTime;
+			Reproduction.TimeSinceLastReproduction += DeltaTime;
+
+			if (LifeSimRules::IsStarved(Vitals.Energy))
+			{
+				Commands.bDie = true;
+				continue;
+			}
+
+			// Claim food within reach, it is eaten when the commands are applied
+			FSimEntityHandle Food;
+			FVector FoodLocation;
+			if (Environment && Environment->FindNearestFood(Location, LifeSimRules::EatRadius, Food, FoodLocation))
+			{
+				Commands.FoodToEat = Food;
+				Commands.FoodLocation = FoodLocation;
+				continue;
+			}
+
+			if (LifeSimRules::CanReproduce(Vitals.Energy, Reproduction.ReproductionThreshold,
+				Reproduction.TimeSinceLastReproduction, Reproduction.ReproductionCooldown))
+			{
+				Commands.bReproduce = true;
+				Commands.OffspringDirection = LifeSimRules::RandomPlanarDirection(Movement.RandomStream);
+			}
+
+			if (bHasBounds)
+			{
+				LifeSimRules::ReflectOffBounds(SimContext->WorldBounds, Location, Movement.CurrentMovementDirection);
+			}
+
+			// Hungry organisms head for remembered or visible food, the rest wander
+			if (LifeSimRules::IsHungry(Vitals.Energy, Vitals.HungerThreshold) && Environment)
+			{
+				const bool bFoundFood = Memory.FoodMemories.FindFood(Now, Memory.MemoryDecayTime,
+					[Environment, &Food, &FoodLocation](const FIntPoint& Cell)
+					{
+						return Environment->FindFoodInCell(Cell, Food, FoodLocation);
+					})
+					|| Environment->FindNearestFood(Location, Vitals.DetectionRadius, Food, FoodLocation);
+
+				if (bFoundFood)
+				{
+					LifeSimRules::MoveToward(Location, FoodLocation, Vitals.MovementSpeed, DeltaTime);
+					continue;
+				}
+			}
+
+			LifeSimRules::Wander(Movement.CurrentMovementDirection, Movement.TimeSinceDirectionChange, Movement.DirectionChangeInterval,
+				Movement.DirectionChangeIntervalMin, Movement.DirectionChangeIntervalMax, Movement.RandomStream,
+				Vitals.MovementSpeed, DeltaTime, Location);
+		}
+	});
+}
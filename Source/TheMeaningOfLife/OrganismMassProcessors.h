@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "OrganismMassProcessors.generated.h"
+
+struct FLifeSimContext;
+
+// Advances every Mass organism by one step, the chunked equivalent of
+// AOrganismActor::SimulateStep. Chunks run across worker threads: each entity
+// only writes its own fragments, world changes go into its command fragment.
+// Run explicitly by UOrganismMassSubsystem, not by the Mass processing phases.
+UCLASS()
+class THEMEANINGOFLIFE_API UOrganismStepProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UOrganismStepProcessor();
+
+	// Read-only world state for the next run
+	void SetSimContext(const FLifeSimContext* InSimContext) { SimContext = InSimContext; }
+	void SetSimulationTime(float InSimulationTime) { SimulationTime = InSimulationTime; }
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+
+	const FLifeSimContext* SimContext;
+
+	// Food memories are stamped with it
+	float SimulationTime;
+};
@@ -0,0 +1,415 @@
+#include "OrganismMassSubsystem.h"
+#include "OrganismMassTypes.h"
+#include "OrganismMassProcessors.h"
+#include "OrganismActor.h"
+#include "FoodActor.h"
+#include "EnvironmentManager.h"
+#include "LifeSimContext.h"
+#include "LifeSimSubsystem.h"
+#include "ResourceComponent.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassExecutionContext.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "LifeSimRenderer.h"
+#include "HAL/IConsoleManager.h"
+#include "LifeSimRules.h"
+#include "LifeSimStats.h"
+#include "LifeSimAllocTracker.h"
+#include "LifeSimMemory.h"
+
+static TAutoConsoleVariable<bool> CVarLifeSimMassOrganisms(
+	TEXT("lifesim.MassOrganisms"),
+	false,
+	TEXT("Create new organisms as Mass entities instead of actors. Organisms that already exist keep their backend."));
+
+UOrganismMassSubsystem::UOrganismMassSubsystem()
+	: EntityManager(nullptr)
+	, NumOrganisms(0)
+	, StepProcessor(nullptr)
+	, Renderer(nullptr)
+{
+}
+
+bool UOrganismMassSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Same worlds as ULifeSimSubsystem
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UOrganismMassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	UMassEntitySubsystem* MassEntitySubsystem = Collection.InitializeDependency<UMassEntitySubsystem>();
+	if (!MassEntitySubsystem)
+		return;
+
+	EntityManager = &MassEntitySubsystem->GetMutableEntityManager();
+
+	OrganismArchetype = EntityManager->CreateArchetype({
+		FOrganismVitalsFragment::StaticStruct(),
+		FOrganismLocationFragment::StaticStruct(),
+		FOrganismMovementFragment::StaticStruct(),
+		FOrganismReproductionFragment::StaticStruct(),
+		FOrganismMemoryFragment::StaticStruct(),
+		FOrganismCommandFragment::StaticStruct(),
+		FOrganismRenderFragment::StaticStruct(),
+		FOrganismMassTag::StaticStruct()
+	});
+
+	StepProcessor = NewObject<UOrganismStepProcessor>(this);
+	StepProcessor->Initialize(*this);
+
+	CommandQuery.AddRequirement<FOrganismCommandFragment>(EMassFragmentAccess::ReadOnly);
+	CommandQuery.AddRequirement<FOrganismLocationFragment>(EMassFragmentAccess::ReadOnly);
+	CommandQuery.AddTagRequirement<FOrganismMassTag>(EMassFragmentPresence::All);
+
+	LocationQuery.AddRequirement<FOrganismLocationFragment>(EMassFragmentAccess::ReadOnly);
+	LocationQuery.AddRequirement<FOrganismRenderFragment>(EMassFragmentAccess::ReadOnly);
+	LocationQuery.AddTagRequirement<FOrganismMassTag>(EMassFragmentPresence::All);
+}
+
+void UOrganismMassSubsystem::Deinitialize()
+{
+	// The entity manager is torn down with its own subsystem
+	EntityManager = nullptr;
+	NumOrganisms = 0;
+	Renderer = nullptr;
+	RenderedEntities.Empty();
+	InstanceTransforms.Empty();
+	PendingCommands.Empty();
+	Materialized.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UOrganismMassSubsystem::IsEnabled()
+{
+	return CVarLifeSimMassOrganisms.GetValueOnGameThread();
+}
+
+SIZE_T UOrganismMassSubsystem::GetFragmentBytesPerOrganism()
+{
+	// Same fragments as OrganismArchetype, plus the entity handle each chunk keeps per entity
+	SIZE_T Bytes = sizeof(FMassEntityHandle);
+	for (const UScriptStruct* Fragment : {
+		FOrganismVitalsFragment::StaticStruct(),
+		FOrganismLocationFragment::StaticStruct(),
+		FOrganismMovementFragment::StaticStruct(),
+		FOrganismReproductionFragment::StaticStruct(),
+		FOrganismMemoryFragment::StaticStruct(),
+		FOrganismCommandFragment::StaticStruct(),
+		FOrganismRenderFragment::StaticStruct() })
+	{
+		Bytes += Fragment->GetStructureSize();
+	}
+	return Bytes;
+}
+
+FMassEntityHandle UOrganismMassSubsystem::SpawnOrganism(const FVector& Location, TSubclassOf<AOrganismActor> OrganismClass)
+{
+	if (!EntityManager)
+		return FMassEntityHandle();
+
+	LIFESIM_LLM_SCOPE(Organisms);
+
+	const AOrganismActor* Defaults = OrganismClass ? OrganismClass->GetDefaultObject<AOrganismActor>() : GetDefault<AOrganismActor>();
+
+	const FMassEntityHandle Entity = EntityManager->CreateEntity(OrganismArchetype);
+	NumOrganisms++;
+
+	FOrganismVitalsFragment& Vitals = EntityManager->GetFragmentDataChecked<FOrganismVitalsFragment>(Entity);
+	Vitals.Energy = Defaults->Energy;
+	Vitals.MaxEnergy = Defaults->MaxEnergy;
+	Vitals.MovementSpeed = Defaults->MovementSpeed;
+	Vitals.DetectionRadius = Defaults->DetectionRadius;
+	Vitals.HungerThreshold = Defaults->HungerThreshold;
+
+	// Same source as AOrganismActor::BeginPlay
+	ULifeSimSubsystem* LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+	if (LifeSim && LifeSim->GetContext().Resources)
+	{
+		Vitals.MetabolismRate = LifeSim->GetContext().Resources->GetOrganismMetabolismRate();
+	}
+
+	EntityManager->GetFragmentDataChecked<FOrganismLocationFragment>(Entity).Location = Location;
+
+	// Entities have no mesh of their own, so they are always instanced
+	if (!Renderer && LifeSim)
+	{
+		Renderer = LifeSim->GetRenderer(true);
+	}
+	if (Renderer)
+	{
+		const FTransform Transform(FQuat::Identity, Location, FVector(0.5f)); // Same size as the actor mesh
+		EntityManager->GetFragmentDataChecked<FOrganismRenderFragment>(Entity).RenderInstance =
+			Renderer->AddInstance(ESimEntityType::Organism, Transform, FLinearColor(0.4f, 0.3f, 0.8f, 1.0f));
+	}
+	EntityManager->GetFragmentDataChecked<FOrganismMovementFragment>(Entity).RandomStream.Initialize(FMath::Rand());
+
+	FOrganismReproductionFragment& Reproduction = EntityManager->GetFragmentDataChecked<FOrganismReproductionFragment>(Entity);
+	Reproduction.ReproductionThreshold = Defaults->ReproductionThreshold;
+	Reproduction.ReproductionCost = Defaults->ReproductionCost;
+	Reproduction.ReproductionCooldown = Defaults->ReproductionCooldown;
+	Reproduction.ReproductionSpawnOffset = Defaults->ReproductionSpawnOffset;
+	Reproduction.TimeSinceLastReproduction = Defaults->ReproductionCooldown;
+	Reproduction.OrganismClass = Defaults->GetClass();
+
+	FOrganismMemoryFragment& Memory = EntityManager->GetFragmentDataChecked<FOrganismMemoryFragment>(Entity);
+	Memory.MaxFoodMemories = Defaults->MaxFoodMemories;
+	Memory.MemoryDecayTime = Defaults->MemoryDecayTime;
+
+	return Entity;
+}
+
+void UOrganismMassSubsystem::Step(float DeltaTime, ULifeSimSubsystem& LifeSim)
+{
+	LIFESIM_SCOPE(STAT_LifeSim_MassStep);
+
+	if (!EntityManager || (NumOrganisms == 0 && RenderedEntities.Num() == 0))
+		return;
+
+	// Parallel phase: chunks are stepped across worker threads. The executor's
+	// dispatch is the task system's own allocation, only the chunks are counted.
+	StepProcessor->SetSimContext(&LifeSim.GetContext());
+	StepProcessor->SetSimulationTime((float)LifeSim.GetSimulationTime());
+
+	FMassProcessingContext ProcessingContext(*EntityManager, DeltaTime);
+	UMassProcessor* Processors[] = { StepProcessor };
+	UE::Mass::Executor::RunProcessorsView(MakeArrayView(Processors), ProcessingContext);
+
+	// Sync point, same rules as the actor backend
+	LIFESIM_ALLOC_SCOPE(Organisms);
+	ApplyCommands(LifeSim);
+
+	UpdateInstances();
+	SyncMaterialized();
+}
+
+void UOrganismMassSubsystem::ApplyCommands(ULifeSimSubsystem& LifeSim)
+{
+	// Gather first: entities cannot be created or destroyed while iterating chunks
+	PendingCommands.Reset();
+
+	FMassExecutionContext ExecutionContext(*EntityManager);
+	CommandQuery.ForEachEntityChunk(*EntityManager, ExecutionContext, [this](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FOrganismCommandFragment> CommandList = Context.GetFragmentView<FOrganismCommandFragment>();
+		const TConstArrayView<FOrganismLocationFragment> LocationList = Context.GetFragmentView<FOrganismLocationFragment>();
+
+		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); EntityIndex++)
+		{
+			const FOrganismCommands& Commands = CommandList[EntityIndex].Commands;
+			if (Commands.bDie || Commands.FoodToEat.IsSet() || Commands.bReproduce)
+			{
+				PendingCommands.Add(FPendingCommand{ Context.GetEntity(EntityIndex), Commands, LocationList[EntityIndex].Location });
+			}
+		}
+	});
+
+	UResourceComponent* Resources = LifeSim.GetContext().Resources;
+
+	for (const FPendingCommand& Pending : PendingCommands)
+	{
+		const FOrganismCommands& Commands = Pending.Commands;
+
+		if (Commands.bDie)
+		{
+			if (Renderer)
+			{
+				Renderer->RemoveInstance(ESimEntityType::Organism,
+					EntityManager->GetFragmentDataChecked<FOrganismRenderFragment>(Pending.Entity).RenderInstance);
+			}
+			EntityManager->DestroyEntity(Pending.Entity);
+			NumOrganisms--;
+			continue;
+		}
+
+		FOrganismVitalsFragment& Vitals = EntityManager->GetFragmentDataChecked<FOrganismVitalsFragment>(Pending.Entity);
+
+		if (Commands.FoodToEat.IsSet())
+		{
+			// Stale if something earlier in this step already ate it
+			AFoodActor* Food = LifeSim.Resolve<AFoodActor>(Commands.FoodToEat);
+			if (!Food)
+				continue;
+
+			FOrganismMemoryFragment& Memory = EntityManager->GetFragmentDataChecked<FOrganismMemoryFragment>(Pending.Entity);
+			if (const AEnvironmentManager* Environment = LifeSim.GetContext().Environment)
+			{
+				Memory.FoodMemories.Remember(Environment->GetFoodCell(Commands.FoodLocation), (float)LifeSim.GetSimulationTime(),
+					Memory.MemoryDecayTime, Memory.MaxFoodMemories);
+			}
+			Vitals.Energy = LifeSimRules::Eat(Vitals.Energy, Food->EnergyValue, Vitals.MaxEnergy);
+			Food->Consume();
+			continue;
+		}
+
+		if (Commands.bReproduce)
+		{
+			// Earlier births in this step already count against the cap
+			if (Resources && !Resources->CanSpawnOrganism())
+				continue;
+
+			FOrganismReproductionFragment& Reproduction = EntityManager->GetFragmentDataChecked<FOrganismReproductionFragment>(Pending.Entity);
+			Vitals.Energy -= Reproduction.ReproductionCost;
+			Reproduction.TimeSinceLastReproduction = 0.0f;
+
+			FVector SpawnLocation = Pending.Location + (Commands.OffspringDirection * LifeSimRules::OffspringDistance);
+			SpawnLocation.Z = Reproduction.ReproductionSpawnOffset;
+			const float OffspringEnergy = Vitals.MaxEnergy * 0.5f;
+			const TSubclassOf<AOrganismActor> OrganismClass = Reproduction.OrganismClass;
+
+			// Baby starts with half energy and takes after its parent
+			const FMassEntityHandle Offspring = SpawnOrganism(SpawnLocation, OrganismClass);
+			if (Offspring.IsSet())
+			{
+				EntityManager->GetFragmentDataChecked<FOrganismVitalsFragment>(Offspring).Energy = OffspringEnergy;
+			}
+		}
+	}
+}
+
+void UOrganismMassSubsystem::DestroyAllOrganisms()
+{
+	if (!EntityManager)
+		return;
+
+	TArray<FMassEntityHandle> Entities;
+	Entities.Reserve(NumOrganisms);
+
+	FMassExecutionContext ExecutionContext(*EntityManager);
+	LocationQuery.ForEachEntityChunk(*EntityManager, ExecutionContext, [this, &Entities](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FOrganismRenderFragment> RenderList = Context.GetFragmentView<FOrganismRenderFragment>();
+
+		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); EntityIndex++)
+		{
+			if (Renderer)
+			{
+				Renderer->RemoveInstance(ESimEntityType::Organism, RenderList[EntityIndex].RenderInstance);
+			}
+			Entities.Add(Context.GetEntity(EntityIndex));
+		}
+	});
+
+	EntityManager->BatchDestroyEntities(Entities);
+	NumOrganisms = 0;
+	RenderedEntities.Reset();
+	InstanceTransforms.Reset();
+
+	// Proxies of the destroyed entities go too
+	SyncMaterialized();
+}
+
+void UOrganismMassSubsystem::UpdateInstances()
+{
+	RenderedEntities.Reset(NumOrganisms);
+	InstanceTransforms.Reset(NumOrganisms);
+
+	const FVector Scale(0.5f, 0.5f, 0.5f); // Same size as the actor mesh
+
+	FMassExecutionContext ExecutionContext(*EntityManager);
+	LocationQuery.ForEachEntityChunk(*EntityManager, ExecutionContext, [this, &Scale](FMassExecutionContext& Context)
+	{
+		const TConstArrayView<FOrganismLocationFragment> LocationList = Context.GetFragmentView<FOrganismLocationFragment>();
+		const TConstArrayView<FOrganismRenderFragment> RenderList = Context.GetFragmentView<FOrganismRenderFragment>();
+
+		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); EntityIndex++)
+		{
+			const FTransform Transform(FQuat::Identity, LocationList[EntityIndex].Location, Scale);
+			RenderedEntities.Add(Context.GetEntity(EntityIndex));
+			InstanceTransforms.Add(Transform);
+
+			// Pushed with everything else when the renderer flushes
+			if (Renderer)
+			{
+				Renderer->SetInstanceTransform(ESimEntityType::Organism, RenderList[EntityIndex].RenderInstance, Transform);
+			}
+		}
+	});
+}
+
+AOrganismActor* UOrganismMassSubsystem::MaterializeNearest(const FVector& Location, float Radius)
+{
+	if (!EntityManager)
+		return nullptr;
+
+	// Picks from the positions drawn last step, which is what the player clicked on
+	int32 NearestIndex = INDEX_NONE;
+	float NearestDistanceSquared = Radius * Radius;
+	for (int32 Index = 0; Index < RenderedEntities.Num(); Index++)
+	{
+		const float DistanceSquared = FVector::DistSquared2D(Location, InstanceTransforms[Index].GetLocation());
+		if (DistanceSquared < NearestDistanceSquared)
+		{
+			NearestDistanceSquared = DistanceSquared;
+			NearestIndex = Index;
+		}
+	}
+
+	if (NearestIndex == INDEX_NONE || !EntityManager->IsEntityValid(RenderedEntities[NearestIndex]))
+		return nullptr;
+
+	const FMassEntityHandle Entity = RenderedEntities[NearestIndex];
+
+	for (const FMaterializedOrganism& Existing : Materialized)
+	{
+		if (Existing.Entity == Entity && Existing.Actor.IsValid())
+		{
+			return Existing.Actor.Get();
+		}
+	}
+
+	// Same class the entity was spawned from, so the proxy looks and selects like the real organism
+	TSubclassOf<AOrganismActor> OrganismClass = EntityManager->GetFragmentDataChecked<FOrganismReproductionFragment>(Entity).OrganismClass;
+	if (!OrganismClass)
+	{
+		OrganismClass = AOrganismActor::StaticClass();
+	}
+
+	const FTransform SpawnTransform(InstanceTransforms[NearestIndex].GetLocation());
+	AOrganismActor* Proxy = GetWorld()->SpawnActorDeferred<AOrganismActor>(OrganismClass, SpawnTransform);
+	if (!Proxy)
+		return nullptr;
+
+	// Set before BeginPlay so the proxy stays out of the registry and is never stepped
+	Proxy->SetMassEntity(Entity);
+	Proxy->FinishSpawning(SpawnTransform);
+
+	Materialized.Add(FMaterializedOrganism{ Entity, Proxy });
+	SyncMaterialized();
+
+	return Proxy;
+}
+
+void UOrganismMassSubsystem::SyncMaterialized()
+{
+	for (int32 Index = Materialized.Num() - 1; Index >= 0; Index--)
+	{
+		FMaterializedOrganism& Entry = Materialized[Index];
+
+		// Deselected proxies destroy themselves
+		AOrganismActor* Proxy = Entry.Actor.Get();
+		if (!Proxy)
+		{
+			Materialized.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// The organism died, take its proxy with it
+		if (!EntityManager->IsEntityValid(Entry.Entity))
+		{
+			Proxy->Destroy();
+			Materialized.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		Proxy->SyncFromMass(
+			EntityManager->GetFragmentDataChecked<FOrganismVitalsFragment>(Entry.Entity),
+			EntityManager->GetFragmentDataChecked<FOrganismLocationFragment>(Entry.Entity).Location,
+			EntityManager->GetFragmentDataChecked<FOrganismMemoryFragment>(Entry.Entity));
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "MassEntityQuery.h"
+#include "LifeSimCommands.h"
+#include "OrganismMassSubsystem.generated.h"
+
+struct FMassEntityManager;
+class AOrganismActor;
+class ULifeSimSubsystem;
+class UOrganismStepProcessor;
+class ALifeSimRenderer;
+
+// Optional organism backend on MassEntity (lifesim.MassOrganisms).
+// Organisms are entities with fragments instead of actors, stepped in chunks
+// by UOrganismStepProcessor and drawn through ALifeSimRenderer. An actor is
+// only materialized for the organism the player selects, so selection and
+// ISelectable behave the same as with actor organisms.
+UCLASS()
+class THEMEANINGOFLIFE_API UOrganismMassSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UOrganismMassSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// True when new organisms should be created as Mass entities
+	static bool IsEnabled();
+
+	// Defaults are read from OrganismClass, so both backends share one set of tuning values
+	FMassEntityHandle SpawnOrganism(const FVector& Location, TSubclassOf<AOrganismActor> OrganismClass = nullptr);
+	int32 GetOrganismCount() const { return NumOrganisms; }
+
+	// Chunk memory one organism entity takes, every fragment in its archetype
+	static SIZE_T GetFragmentBytesPerOrganism();
+
+	// Removes every organism entity and any proxy actor along with it
+	void DestroyAllOrganisms();
+
+	// Steps, applies and draws every Mass organism. Called by ULifeSimSubsystem on the game thread.
+	void Step(float DeltaTime, ULifeSimSubsystem& LifeSim);
+
+	// Spawns a proxy actor for the organism nearest to Location, or returns the
+	// existing one. The proxy follows the entity and is destroyed on deselect.
+	AOrganismActor* MaterializeNearest(const FVector& Location, float Radius);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void ApplyCommands(ULifeSimSubsystem& LifeSim);
+	void UpdateInstances();
+	void SyncMaterialized();
+
+	struct FMaterializedOrganism
+	{
+		FMassEntityHandle Entity;
+		TWeakObjectPtr<AOrganismActor> Actor;
+	};
+
+	FMassEntityManager* EntityManager;
+	FMassArchetypeHandle OrganismArchetype;
+	int32 NumOrganisms;
+
+	// Game-thread passes over every organism chunk
+	FMassEntityQuery CommandQuery;
+	FMassEntityQuery LocationQuery;
+
+	struct FPendingCommand
+	{
+		FMassEntityHandle Entity;
+		FOrganismCommands Commands;
+		FVector Location;
+	};
+
+	// Reused between steps
+	TArray<FPendingCommand> PendingCommands;
+
+	UPROPERTY()
+	UOrganismStepProcessor* StepProcessor;
+
+	// Shared with the actor backends, each entity keeps its instance in FOrganismRenderFragment
+	UPROPERTY()
+	ALifeSimRenderer* Renderer;
+
+	// Entities and the transforms drawn last step, for picking
+	TArray<FMassEntityHandle> RenderedEntities;
+	TArray<FTransform> InstanceTransforms;
+
+	TArray<FMaterializedOrganism> Materialized;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "LifeSimCommands.h"
+#include "OrganismActor.h"
+#include "OrganismMassTypes.generated.h"
+
+// Fragments for organisms simulated as Mass entities instead of actors.
+// They carry the same state as AOrganismActor, split by what each part of the
+// step touches so a chunk only streams the data it needs.
+
+USTRUCT()
+struct FOrganismMassTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+USTRUCT()
+struct FOrganismVitalsFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	float Energy = 50.0f;
+	float MaxEnergy = 100.0f;
+	float MetabolismRate = 0.0f;
+	float Age = 0.0f;
+	float MovementSpeed = 100.0f;
+	float DetectionRadius = 250.0f;
+	float HungerThreshold = 40.0f;
+};
+
+USTRUCT()
+struct FOrganismLocationFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector Location = FVector::ZeroVector;
+};
+
+USTRUCT()
+struct FOrganismMovementFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector CurrentMovementDirection = FVector::ZeroVector;
+	float TimeSinceDirectionChange = 0.0f;
+	float DirectionChangeInterval = 0.0f;
+	float DirectionChangeIntervalMin = 2.0f;
+	float DirectionChangeIntervalMax = 5.0f;
+
+	// Per-entity stream, chunks run on worker threads
+	FRandomStream RandomStream;
+};
+
+USTRUCT()
+struct FOrganismReproductionFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	float ReproductionThreshold = 90.0f;
+	float ReproductionCost = 50.0f;
+	float ReproductionCooldown = 120.0f;
+	float ReproductionSpawnOffset = 25.0f;
+	float TimeSinceLastReproduction = 120.0f;
+
+	// Class the tuning came from, passed on to offspring and used for the selection proxy.
+	// Not seen by GC, organism classes are native or Blueprint assets that stay loaded for the session.
+	TSubclassOf<AOrganismActor> OrganismClass;
+};
+
+USTRUCT()
+struct FOrganismMemoryFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	int32 MaxFoodMemories = 3;
+	float MemoryDecayTime = 300.0f;
+
+	// Inline so remembering food never allocates
+	FFoodMemoryRing FoodMemories;
+};
+
+// Instance drawing this organism in ALifeSimRenderer
+USTRUCT()
+struct FOrganismRenderFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	int32 RenderInstance = INDEX_NONE;
+};
+
+// Structural changes recorded by the step processor, applied on the game thread
+USTRUCT()
+struct FOrganismCommandFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FOrganismCommands Commands;
+};
@@ -2,14 +2,19 @@
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "FoodActor.h"
-#include "Kismet/GameplayStatics.h"
-#include "LifeSimPlayerController.h"
-#include "ResourceComponent.h"
+#include "EnvironmentManager.h"
+#include "LifeSimSubsystem.h"
+#include "LifeSimRenderer.h"
+#include "LifeSimStats.h"
+#include "LifeSimMemory.h"
+
+static const FLinearColor HealthyPlantColor(0.2f, 0.7f, 0.2f, 1.0f);
 
 // Sets default values
 APlantActor::APlantActor()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Updated by ULifeSimSubsystem at lifesim.Rate.PlantLogic, staggered across frames
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Create mesh component
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
@@ -23,17 +28,11 @@ APlantActor::APlantActor()
 		MeshComponent->SetWorldScale3D(FVector(0.3f, 0.3f, 1.5f));
 	}
 
-    // Load a basic material and set to green
+    // Load a basic material, tinted green in BeginPlay
     static ConstructorHelpers::FObjectFinder<UMaterial> Material(TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
     if (Material.Succeeded())
     {
-        UMaterialInstanceDynamic* DynMaterial = UMaterialInstanceDynamic::Create(Material.Object, this);
-        if (DynMaterial)
-        {
-            // Green color for plants
-            DynMaterial->SetVectorParameterValue(FName("Color"), FLinearColor(0.2f, 0.7f, 0.2f, 1.0f));
-            MeshComponent->SetMaterial(0, DynMaterial);
-        }
+        MeshComponent->SetMaterial(0, Material.Object);
     }
 
     // Water system
@@ -50,24 +49,80 @@ APlantActor::APlantActor()
 
     Age = 0.0f;
     TimeSinceLastSpawn = 0.0f;
+    LiveFoodCount = 0;
 
     PlantName = TEXT(""); // Empty for now
     bIsSelected = false;
+
+    LifeSim = nullptr;
+    Renderer = nullptr;
+    RenderInstance = INDEX_NONE;
+    DynMaterial = nullptr;
+    CurrentColor = HealthyPlantColor;
 }
 
 // Called when the game starts or when spawned
 void APlantActor::BeginPlay()
 {
+    LIFESIM_LLM_SCOPE(Plants);
     Super::BeginPlay();
 
     // UE_LOG(LogTemp, Warning, TEXT("Plant spawned and ready to produce food"));
-    AddPlant();
+    LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+    if (LifeSim)
+    {
+        SimHandle = LifeSim->RegisterEntity(this, ESimEntityType::Plant);
+        Renderer = LifeSim->GetRenderer();
+
+        // Indexed so weather only has to look at the cells it covers
+        if (AEnvironmentManager* Environment = LifeSim->GetContext().Environment)
+        {
+            Environment->RegisterPlant(SimHandle, GetActorLocation());
+        }
+    }
+
+    if (Renderer)
+    {
+        // Drawn as an instance, the mesh stays around for selection traces
+        MeshComponent->SetHiddenInGame(true);
+        RenderInstance = Renderer->AddInstance(ESimEntityType::Plant, MeshComponent->GetComponentTransform(), CurrentColor);
+    }
+    else if (!ULifeSimSubsystem::IsHeadless())
+    {
+        DynMaterial = MeshComponent->CreateAndSetMaterialInstanceDynamic(0);
+        if (DynMaterial)
+        {
+            DynMaterial->SetVectorParameterValue(FName("Color"), CurrentColor);
+        }
+    }
 }
 
-// Called every frame
-void APlantActor::Tick(float DeltaTime)
+void APlantActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
+    if (LifeSim)
+    {
+        if (AEnvironmentManager* Environment = LifeSim->GetContext().Environment)
+        {
+            Environment->UnregisterPlant(SimHandle, GetActorLocation());
+        }
+
+        LifeSim->UnregisterEntity(SimHandle);
+        SimHandle.Reset();
+    }
+
+    if (Renderer)
+    {
+        Renderer->RemoveInstance(ESimEntityType::Plant, RenderInstance);
+        Renderer = nullptr;
+        RenderInstance = INDEX_NONE;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void APlantActor::UpdatePlant(float DeltaTime)
+{
+    LIFESIM_SCOPE(STAT_LifeSim_PlantUpdate);
 
     Age += DeltaTime;
     TimeSinceLastSpawn += DeltaTime;
@@ -100,7 +155,7 @@ void APlantActor::Tick(float DeltaTime)
     if (TimeSinceLastSpawn >= FoodSpawnInterval && Age >= FoodSpawnInterval)
     {
         // Only spawn if we don't have too much food nearby
-        if (CountNearbyFood() < MaxFoodNearby)
+        if (LiveFoodCount < MaxFoodNearby)
         {
             SpawnFood();
         }
@@ -111,76 +166,57 @@ void APlantActor::Tick(float DeltaTime)
 
 void APlantActor::UpdatePlantColor(bool bIsLowWater)
 {
-    if (MeshComponent && !bIsSelected)
+    if (bIsSelected)
+        return;
+
+    if (bIsLowWater)
     {
-        UMaterialInstanceDynamic* DynMat = Cast<UMaterialInstanceDynamic>(MeshComponent->GetMaterial(0));
-        if (DynMat)
-        {
-            if (bIsLowWater)
-            {
-                // Brownish/dying color
-                float WaterPercent = Water / MaxWater;
-                DynMat->SetVectorParameterValue(FName("Color"),
-                    FLinearColor(0.4f, 0.3f + (WaterPercent * 0.4f), 0.1f, 1.0f));
-            }
-            else
-            {
-                // Healthy green
-                DynMat->SetVectorParameterValue(FName("Color"),
-                    FLinearColor(0.2f, 0.7f, 0.2f, 1.0f));
-            }
-        }
+        // Brownish/dying color
+        float WaterPercent = Water / MaxWater;
+        SetPlantColor(FLinearColor(0.4f, 0.3f + (WaterPercent * 0.4f), 0.1f, 1.0f));
+    }
+    else
+    {
+        // Healthy green
+        SetPlantColor(HealthyPlantColor);
     }
 }
 
-void APlantActor::AddWater(float Amount)
+void APlantActor::SetPlantColor(const FLinearColor& Color)
 {
-    Water += Amount;
-    Water = FMath::Min(Water, MaxWater);
+    // Healthy plants keep the same color every tick, skip the update
+    if (Color == CurrentColor)
+        return;
 
-    UE_LOG(LogTemp, Log, TEXT("Plant watered! Water now: %.1f"), Water);
-}
+    CurrentColor = Color;
 
-void APlantActor::AddPlant()
-{
-    // Add 1 Plant to the ResourceComponent's PlantCount
-    if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
+    if (Renderer)
     {
-        if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
-        {
-            bool bPlantAdded = Resources->AddPlant();
-            if (!bPlantAdded)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("Plant can't be added"));
-            }
-        }
+        Renderer->SetInstanceColor(ESimEntityType::Plant, RenderInstance, Color);
+    }
+    else if (DynMaterial)
+    {
+        DynMaterial->SetVectorParameterValue(FName("Color"), Color);
     }
 }
 
-void APlantActor::RemovePlant()
+void APlantActor::AddWater(float Amount)
 {
-    // Remove 1 Plant from the ResourceComponent's PlantCount
-    if (ALifeSimPlayerController* PC = Cast<ALifeSimPlayerController>(GetWorld()->GetFirstPlayerController()))
-    {
-        if (UResourceComponent* Resources = PC->FindComponentByClass<UResourceComponent>())
-        {
-            bool bPlantRemoved = Resources->RemovePlant();
-            if (!bPlantRemoved)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("Plant can't be removed"));
-            }
-        }
-    }
+    Water += Amount;
+    Water = FMath::Min(Water, MaxWater);
+
+    UE_LOG(LogTemp, Verbose, TEXT("Plant watered! Water now: %.1f"), Water);
 }
 
 void APlantActor::Die()
 {
-    RemovePlant();
     Destroy();
 }
 
 void APlantActor::SpawnFood()
 {
+    LIFESIM_SCOPE(STAT_LifeSim_PlantSpawnFood);
+
     if (!FoodActorClass)
     {
         UE_LOG(LogTemp, Warning, TEXT("Plant has no FoodActorClass set!"));
@@ -197,52 +233,39 @@ void APlantActor::SpawnFood()
     FVector SpawnLocation = GetActorLocation() + RandomOffset;
     SpawnLocation.Z = 50.0f; // Spawn at consistent height
 
-    FActorSpawnParameters SpawnParams;
-    AActor* NewFood = GetWorld()->SpawnActor<AFoodActor>(FoodActorClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
-
-    if (NewFood)
+    // Reuses food that was eaten when there is any
+    LIFESIM_LLM_SCOPE(Food);
+    AFoodActor* Food = nullptr;
+    if (LifeSim)
     {
-        SpawnedFood.Add(NewFood);
-        // UE_LOG(LogTemp, Log, TEXT("Plant spawned food! Total nearby: %d"), CountNearbyFood());
+        Food = LifeSim->AcquireActor<AFoodActor>(FoodActorClass, SpawnLocation);
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        Food = GetWorld()->SpawnActor<AFoodActor>(FoodActorClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
     }
-}
-
-int32 APlantActor::CountNearbyFood()
-{
-    // Clean up null references
-    SpawnedFood.RemoveAll([](AActor* Food) { return Food == nullptr || !IsValid(Food); });
-
-    // Count food within check radius
-    int32 Count = 0;
-    TArray<AActor*> AllFood;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AFoodActor::StaticClass(), AllFood);
 
-    for (AActor* Food : AllFood)
+    if (Food)
     {
-        float Distance = FVector::Dist(GetActorLocation(), Food->GetActorLocation());
-        if (Distance <= FoodCheckRadius)
-        {
-            Count++;
-        }
+        // The food tells us when it is eaten
+        Food->SetOwnerPlant(SimHandle);
+        LiveFoodCount++;
     }
+    // UE_LOG(LogTemp, Log, TEXT("Plant spawned food! Total nearby: %d"), LiveFoodCount);
+}
 
-    return Count;
+void APlantActor::OnFoodRemoved()
+{
+    LiveFoodCount = FMath::Max(LiveFoodCount - 1, 0);
 }
 
 void APlantActor::OnSelected()
 {
     bIsSelected = true;
 
-    // Optional: Change color or add visual feedback
-    if (MeshComponent)
-    {
-        // Make it slightly brighter when selected
-        UMaterialInstanceDynamic* DynMat = Cast<UMaterialInstanceDynamic>(MeshComponent->GetMaterial(0));
-        if (DynMat)
-        {
-            DynMat->SetVectorParameterValue(FName("Color"), FLinearColor(0.3f, 1.0f, 0.3f, 1.0f));
-        }
-    }
+    // Make it slightly brighter when selected
+    SetPlantColor(FLinearColor(0.3f, 1.0f, 0.3f, 1.0f));
 
     UE_LOG(LogTemp, Log, TEXT("Plant selected"));
 }
@@ -251,15 +274,8 @@ void APlantActor::OnDeselected()
 {
     bIsSelected = false;
 
-    // Reset to normal color
-    if (MeshComponent)
-    {
-        UMaterialInstanceDynamic* DynMat = Cast<UMaterialInstanceDynamic>(MeshComponent->GetMaterial(0));
-        if (DynMat)
-        {
-            DynMat->SetVectorParameterValue(FName("Color"), FLinearColor(0.2f, 0.7f, 0.2f, 1.0f));
-        }
-    }
+    // Reset to normal color, the next tick tints it again if water is low
+    SetPlantColor(HealthyPlantColor);
 
     UE_LOG(LogTemp, Log, TEXT("Plant deselected"));
 }
@@ -273,16 +289,12 @@ FString APlantActor::GetDisplayName()
     return PlantName;
 }
 
-TArray<TPair<FString, FString>> APlantActor::GetDisplayInfo()
+void APlantActor::GetDisplayProperties(TArray<FSelectableProperty>& OutProperties)
 {
-    TArray<TPair<FString, FString>> Info;
-
-    Info.Add(TPair<FString, FString>(TEXT("Age"), FString::Printf(TEXT("%.1f seconds"), Age)));
-    Info.Add(TPair<FString, FString>(TEXT("Water"), FString::Printf(TEXT("%.1f / %.1f"), Water, MaxWater)));
-    Info.Add(TPair<FString, FString>(TEXT("Food Spawn Interval"), FString::Printf(TEXT("%.1fs"), FoodSpawnInterval)));
-    Info.Add(TPair<FString, FString>(TEXT("Max Food Nearby"), FString::Printf(TEXT("%d"), MaxFoodNearby)));
-    Info.Add(TPair<FString, FString>(TEXT("Current Nearby Food"), FString::Printf(TEXT("%d"), CountNearbyFood())));
-    Info.Add(TPair<FString, FString>(TEXT("Time Until Next Food"), FString::Printf(TEXT("%.1fs"), FoodSpawnInterval - TimeSinceLastSpawn)));
-
-    return Info;
+    OutProperties.Add(FSelectableProperty::Number(TEXT("Age"), Age, 1, TEXT(" seconds")));
+    OutProperties.Add(FSelectableProperty::Ratio(TEXT("Water"), Water, MaxWater, 1));
+    OutProperties.Add(FSelectableProperty::Number(TEXT("Food Spawn Interval"), FoodSpawnInterval, 1, TEXT("s")));
+    OutProperties.Add(FSelectableProperty::Count(TEXT("Max Food Nearby"), MaxFoodNearby));
+    OutProperties.Add(FSelectableProperty::Count(TEXT("Current Nearby Food"), LiveFoodCount));
+    OutProperties.Add(FSelectableProperty::Number(TEXT("Time Until Next Food"), FoodSpawnInterval - TimeSinceLastSpawn, 1, TEXT("s")));
 }
\ No newline at end of file
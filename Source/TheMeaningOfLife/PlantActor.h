@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Selectable.h"
+#include "SimEntityHandle.h"
 #include "PlantActor.generated.h"
 
 UCLASS()
@@ -17,13 +18,14 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // Selectable interface implementation
     virtual void OnSelected() override;
     virtual void OnDeselected() override;
     virtual FString GetDisplayName() override;
-    virtual TArray<TPair<FString, FString>> GetDisplayInfo() override;
+    virtual void GetDisplayProperties(TArray<FSelectableProperty>& OutProperties) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Plant")
     FString PlantName;
@@ -31,7 +33,8 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Plant")
     bool bIsSelected;
 
-    virtual void Tick(float DeltaTime) override;
+    // Water, tint and food production. DeltaTime is the time since this plant last updated.
+    void UpdatePlant(float DeltaTime);
 
     // Visual representation
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Plant")
@@ -51,7 +54,7 @@ public:
     float FoodSpawnRadius; // How far from plant to spawn food
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Plant|Production")
-    float FoodCheckRadius; // Radius to check for existing food
+    float FoodCheckRadius; // Radius to check for existing food. Production now counts the plant's own food instead.
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Plant")
     float Age;
@@ -77,14 +80,37 @@ public:
     UFUNCTION()
     void AddWater(float Amount);
 
+    // Called by food this plant spawned when it leaves play
+    void OnFoodRemoved();
+
+    int32 GetLiveFoodCount() const { return LiveFoodCount; }
+
 private:
     void SpawnFood();
-    int32 CountNearbyFood();
     void UpdatePlantColor(bool bIsLowWater);
-    void AddPlant();
-    void RemovePlant();
+    void SetPlantColor(const FLinearColor& Color);
     void Die();
 
     float TimeSinceLastSpawn;
-    TArray<AActor*> SpawnedFood;
+
+    // Food spawned by this plant that has not been eaten yet. It always lands
+    // within FoodSpawnRadius, so this is the food nearby that the plant made.
+    int32 LiveFoodCount;
+
+    // Registry entry, valid between BeginPlay and EndPlay
+    UPROPERTY()
+    class ULifeSimSubsystem* LifeSim;
+
+    FSimEntityHandle SimHandle;
+
+    // Where the color goes: an instance when instanced rendering is on, otherwise our own material
+    UPROPERTY()
+    class ALifeSimRenderer* Renderer;
+
+    int32 RenderInstance;
+
+    UPROPERTY()
+    class UMaterialInstanceDynamic* DynMaterial;
+
+    FLinearColor CurrentColor;
 };
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PooledActor.generated.h"
+
+UINTERFACE(MinimalAPI)
+class UPooledActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// Actors that ULifeSimSubsystem parks instead of destroying. A parked actor
+// stays alive, hidden and without collision, until a later spawn reuses it.
+class THEMEANINGOFLIFE_API IPooledActor
+{
+	GENERATED_BODY()
+
+public:
+	// Taken from the pool and already moved to its spawn location.
+	// Reset to class defaults and rejoin the simulation.
+	virtual void OnAcquiredFromPool() = 0;
+
+	// About to be parked. Leave the simulation as EndPlay would.
+	virtual void OnReleasedToPool() = 0;
+};
+
+// Parked actors of one class
+USTRUCT()
+struct FLifeSimActorPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> Actors;
+};
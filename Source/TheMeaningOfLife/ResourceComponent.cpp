@@ -2,11 +2,14 @@
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "OrganismActor.h"
+#include "LifeSimSubsystem.h"
 
 // Sets default values for this component's properties
 UResourceComponent::UResourceComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	// Updated by ULifeSimSubsystem at lifesim.Rate.ResourceAccounting
+	PrimaryComponentTick.bCanEverTick = false;
+	bWantsInitializeComponent = true;
 
 	Energy = 250.0f;
 	MaxEnergy = 1000.0f;
@@ -20,11 +23,11 @@ UResourceComponent::UResourceComponent()
 
 	OrganismMetabolismRate = 0.5f;
 	OrganismEnergyContribution = 0.2f;
-	OrganismCount = 0;
 
 	PlantConsumptionRate = 0.5f;
 	PlantWaterContribution = 0.2f;
-	PlantCount = 0;
+
+	LifeSim = nullptr;
 }
 
 
@@ -36,21 +39,39 @@ void UResourceComponent::BeginPlay()
 	
 }
 
+void UResourceComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	LifeSim = GetWorld()->GetSubsystem<ULifeSimSubsystem>();
+	if (LifeSim)
+	{
+		LifeSim->RegisterResources(this);
+	}
+}
 
-// Called every frame
-void UResourceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UResourceComponent::UninitializeComponent()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (LifeSim)
+	{
+		LifeSim->UnregisterResources(this);
+	}
+
+	Super::UninitializeComponent();
+}
+
 
+void UResourceComponent::UpdateResources(float DeltaTime)
+{
 	// Player metabolism - lose energy
 	Energy -= PlayerMetabolismRate * DeltaTime;
 	Energy = FMath::Max(Energy, 0.0f);
 
 	// Organism metabolism - gain energy
-	AddEnergy(OrganismCount * OrganismEnergyContribution * OrganismMetabolismRate * DeltaTime);
+	AddEnergy(GetOrganismCount() * OrganismEnergyContribution * OrganismMetabolismRate * DeltaTime);
 
 	// Plant consumption - gain water
-	AddWater(PlantCount * PlantWaterContribution * PlantConsumptionRate * DeltaTime);
+	AddWater(GetPlantCount() * PlantWaterContribution * PlantConsumptionRate * DeltaTime);
 
 	// Check for death
 	if (Energy <= 0.0f)
@@ -102,12 +123,12 @@ bool UResourceComponent::SpendResources(float EnergyCost, float WaterCost, int32
 
 int32 UResourceComponent::GetOrganismCount()
 {
-	return OrganismCount;
+	return LifeSim ? LifeSim->GetCount(ESimEntityType::Organism) : 0;
 }
 
 int32 UResourceComponent::GetPlantCount()
 {
-	return PlantCount;
+	return LifeSim ? LifeSim->GetCount(ESimEntityType::Plant) : 0;
 }
 
 int32 UResourceComponent::GetOrganismCap()
@@ -120,6 +141,12 @@ int32 UResourceComponent::GetPlantCap()
 	return PlantCap;
 }
 
+void UResourceComponent::SetPopulationCaps(int32 NewOrganismCap, int32 NewPlantCap)
+{
+	OrganismCap = NewOrganismCap;
+	PlantCap = NewPlantCap;
+}
+
 float UResourceComponent::GetEnergyPercent()
 {
 	return Energy / MaxEnergy;
@@ -132,12 +159,12 @@ float UResourceComponent::GetWaterPercent()
 
 FString UResourceComponent::OrganismInfoToString()
 {
-	return FString("Organisms: " + FString::FromInt(OrganismCount) + "/" + FString::FromInt(OrganismCap));
+	return FString("Organisms: " + FString::FromInt(GetOrganismCount()) + "/" + FString::FromInt(OrganismCap));
 }
 
 FString UResourceComponent::PlantInfoToString()
 {
-	return FString("Plants: " + FString::FromInt(PlantCount) + "/" + FString::FromInt(PlantCap));
+	return FString("Plants: " + FString::FromInt(GetPlantCount()) + "/" + FString::FromInt(PlantCap));
 }
 
 FString UResourceComponent::LifeEssenceInfoToString()
@@ -148,7 +175,7 @@ FString UResourceComponent::LifeEssenceInfoToString()
 bool UResourceComponent::CanSpawnOrganism()
 {
 	// Check if we have room to spawn another organism
-	if (OrganismCount < OrganismCap)
+	if (GetOrganismCount() < OrganismCap)
 	{
 		return true;
 	}
@@ -160,7 +187,7 @@ bool UResourceComponent::CanSpawnOrganism()
 bool UResourceComponent::CanSpawnPlant()
 {
 	// Check if we have room to spawn another plant
-	if (PlantCount < PlantCap)
+	if (GetPlantCount() < PlantCap)
 	{
 		return true;
 	}
@@ -172,48 +199,4 @@ bool UResourceComponent::CanSpawnPlant()
 float UResourceComponent::GetOrganismMetabolismRate()
 {
 	return OrganismMetabolismRate;
-}
-
-bool UResourceComponent::AddOrganism()
-{
-	if (OrganismCount < OrganismCap)
-	{
-		OrganismCount += 1;
-		return true;
-	}
-
-	return false;
-}
-
-bool UResourceComponent::RemoveOrganism()
-{
-	if (OrganismCount > 0)
-	{
-		OrganismCount -= 1;
-		return true;
-	}
-
-	return false;
-}
-
-bool UResourceComponent::AddPlant()
-{
-	if (PlantCount < PlantCap)
-	{
-		PlantCount += 1;
-		return true;
-	}
-
-	return false;
-}
-
-bool UResourceComponent::RemovePlant()
-{
-	if (PlantCount > 0)
-	{
-		PlantCount -= 1;
-		return true;
-	}
-
-	return false;
 }
\ No newline at end of file
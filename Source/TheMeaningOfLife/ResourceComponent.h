@@ -45,27 +45,30 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Registers with the simulation context before any actor begins play
+	virtual void InitializeComponent() override;
+	virtual void UninitializeComponent() override;
+
 private:
-	int32 OrganismCount;
 	int32 OrganismCap;
 	float OrganismMetabolismRate;
-	int32 PlantCount;
 	int32 PlantCap;
 	float PlantConsumptionRate;
 
+	// Population counts are read from the entity registry
+	UPROPERTY()
+	class ULifeSimSubsystem* LifeSim;
+
 public:	
-	// Called every frame
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// Player metabolism and income. DeltaTime is the time since the last update.
+	void UpdateResources(float DeltaTime);
 	void OnPlayerDeath();
 	void AddEnergy(float Amount);
 	void AddWater(float Amount);
 	bool SpendResources(float EnergyCost, float WaterCost, int32 LifeEssenceCost);
 	bool CanSpawnOrganism();
 	bool CanSpawnPlant();
-	bool AddOrganism();
-	bool RemoveOrganism();
-	bool AddPlant();
-	bool RemovePlant();
+	void SetPopulationCaps(int32 NewOrganismCap, int32 NewPlantCap);
 	float GetOrganismMetabolismRate();
 	int32 GetOrganismCount();
 	int32 GetOrganismCap();
@@ -4,3 +4,72 @@
 #include "Selectable.h"
 
 // Add default functionality here for any ISelectable functions that are not pure virtual.
+
+// Up to two decimals, the panel never needs more
+static FString FormatDecimal(double Value, int32 Decimals)
+{
+    switch (Decimals)
+    {
+    case 0: return FString::Printf(TEXT("%.0f"), Value);
+    case 1: return FString::Printf(TEXT("%.1f"), Value);
+    default: return FString::Printf(TEXT("%.2f"), Value);
+    }
+}
+
+FSelectableProperty FSelectableProperty::Count(const TCHAR* Name, int32 Value)
+{
+    FSelectableProperty Property;
+    Property.Name = Name;
+    Property.Type = ESelectablePropertyType::Count;
+    Property.Value = Value;
+    return Property;
+}
+
+FSelectableProperty FSelectableProperty::Number(const TCHAR* Name, double Value, int32 Decimals, const TCHAR* Suffix)
+{
+    FSelectableProperty Property;
+    Property.Name = Name;
+    Property.Type = ESelectablePropertyType::Number;
+    Property.Value = Value;
+    Property.Decimals = Decimals;
+    Property.Suffix = Suffix;
+    return Property;
+}
+
+FSelectableProperty FSelectableProperty::Ratio(const TCHAR* Name, double Value, double Max, int32 Decimals)
+{
+    FSelectableProperty Property;
+    Property.Name = Name;
+    Property.Type = ESelectablePropertyType::Ratio;
+    Property.Value = Value;
+    Property.Max = Max;
+    Property.Decimals = Decimals;
+    return Property;
+}
+
+bool FSelectableProperty::DisplaysSameAs(const FSelectableProperty& Other) const
+{
+    if (Type != Other.Type || Decimals != Other.Decimals
+        || FCString::Strcmp(Name, Other.Name) != 0 || FCString::Strcmp(Suffix, Other.Suffix) != 0)
+    {
+        return false;
+    }
+
+    // Rounded the way %.*f rounds, closely enough for a display
+    const double Scale = FMath::Pow(10.0, (double)FMath::Clamp(Decimals, 0, 2));
+    return FMath::RoundToInt64(Value * Scale) == FMath::RoundToInt64(Other.Value * Scale)
+        && FMath::RoundToInt64(Max * Scale) == FMath::RoundToInt64(Other.Max * Scale);
+}
+
+FString FSelectableProperty::FormatValue() const
+{
+    switch (Type)
+    {
+    case ESelectablePropertyType::Count:
+        return FString::Printf(TEXT("%d"), (int32)Value);
+    case ESelectablePropertyType::Ratio:
+        return FormatDecimal(Value, Decimals) + TEXT(" / ") + FormatDecimal(Max, Decimals);
+    default:
+        return FormatDecimal(Value, Decimals) + Suffix;
+    }
+}
@@ -4,6 +4,35 @@
 #include "UObject/Interface.h"
 #include "Selectable.generated.h"
 
+enum class ESelectablePropertyType : uint8
+{
+    Count,  // Whole number
+    Number, // Value with Decimals and an optional Suffix
+    Ratio   // Value / Max
+};
+
+// One row of the selection panel. Carries the raw value and how to show it,
+// so the panel can tell when a row really changed and only formats those.
+// Name and Suffix must outlive the property, string literals in practice.
+struct THEMEANINGOFLIFE_API FSelectableProperty
+{
+    const TCHAR* Name = TEXT("");
+    ESelectablePropertyType Type = ESelectablePropertyType::Number;
+    double Value = 0.0;
+    double Max = 0.0;
+    int32 Decimals = 0; // 0 to 2
+    const TCHAR* Suffix = TEXT("");
+
+    static FSelectableProperty Count(const TCHAR* Name, int32 Value);
+    static FSelectableProperty Number(const TCHAR* Name, double Value, int32 Decimals, const TCHAR* Suffix = TEXT(""));
+    static FSelectableProperty Ratio(const TCHAR* Name, double Value, double Max, int32 Decimals);
+
+    // True when both would format to the same text, compared on rounded values
+    bool DisplaysSameAs(const FSelectableProperty& Other) const;
+
+    FString FormatValue() const;
+};
+
 UINTERFACE(MinimalAPI, Blueprintable)
 class USelectable : public UInterface
 {
@@ -24,6 +53,7 @@ public:
     // Get display name
     virtual FString GetDisplayName() = 0;
 
-    // Get info to display (returns array of property names and values)
-    virtual TArray<TPair<FString, FString>> GetDisplayInfo() = 0;
+    // Properties to display, in panel order. OutProperties arrives empty and
+    // is reused between refreshes, the same object should list the same rows.
+    virtual void GetDisplayProperties(TArray<FSelectableProperty>& OutProperties) = 0;
 };
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimEntityHandle.generated.h"
+
+UENUM(BlueprintType)
+enum class ESimEntityType : uint8
+{
+	Organism,
+	Plant,
+	Food,
+	Count UMETA(Hidden)
+};
+
+// Stable reference to an entity registered with the LifeSim subsystem.
+// A handle goes stale (resolves to nullptr) once its entity is unregistered,
+// even if the slot is reused for a new entity later on.
+USTRUCT(BlueprintType)
+struct FSimEntityHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index;
+
+	UPROPERTY()
+	uint32 Generation;
+
+	FSimEntityHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+
+	FSimEntityHandle(int32 InIndex, uint32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{
+	}
+
+	bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	void Reset()
+	{
+		Index = INDEX_NONE;
+		Generation = 0;
+	}
+
+	bool operator==(const FSimEntityHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+
+	bool operator!=(const FSimEntityHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FSimEntityHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
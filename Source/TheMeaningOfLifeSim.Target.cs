@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Simulation only: no renderer, audio or UI. For long headless runs with
+// -run=LifeSimHeadless, see ULifeSimHeadlessCommandlet.
+public class TheMeaningOfLifeSimTarget : TargetRules
+{
+	public TheMeaningOfLifeSimTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
+		ExtraModuleNames.Add("TheMeaningOfLife");
+
+		// Runs report through the log, keep it even in shipping
+		bUseLoggingInShipping = true;
+	}
+}